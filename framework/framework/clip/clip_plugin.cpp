@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include "default_clip.h"
 #include "pasteboard_event_dfx.h"
 #include "pasteboard_hilog.h"
@@ -141,6 +143,12 @@ void ClipPlugin::SetMaxLocalCapacity(int64_t maxLocalCapacity)
     (void)maxLocalCapacity;
 }
 
+bool ClipPlugin::IsTypeFrame(const std::vector<uint8_t> &mimeTypes)
+{
+    return mimeTypes.size() >= sizeof(TYPE_FRAME_HEAD) &&
+        std::equal(std::begin(TYPE_FRAME_HEAD), std::end(TYPE_FRAME_HEAD), mimeTypes.begin());
+}
+
 int32_t ClipPlugin::GetMimeTypes(std::vector<uint8_t> &mimeTypes, const GlobalEvent &event)
 {
     (void)mimeTypes;
@@ -14,9 +14,7 @@
  */
 
 #include "device/dev_profile.h"
-#include <thread>
 
-#include "common/pasteboard_common_utils.h"
 #include "device/device_profile_proxy.h"
 #include "device/dm_adapter.h"
 #include "ffrt/ffrt_utils.h"
@@ -47,23 +45,19 @@ void DevProfile::PostDelayReleaseProxy()
     static FFRTTimer ffrtTimer("release_dp_proxy");
 
     FFRTTask task = [this]() {
-        std::thread thread([=]() {
-            std::lock_guard lock(proxyMutex_);
-            PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "execute delay task");
-            if (proxy_ == nullptr) {
-                return;
-            }
-
-            if (subscribeUdidList_.empty()) {
-                PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "deinit dp proxy");
-                proxy_ = nullptr;
-            }
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "PostDelayReleas");
-        thread.detach();
+        std::lock_guard lock(proxyMutex_);
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "execute delay task");
+        if (proxy_ == nullptr) {
+            return;
+        }
+
+        if (subscribeUdidList_.empty()) {
+            PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "deinit dp proxy");
+            proxy_ = nullptr;
+        }
     };
 
-    ffrtTimer.SetTimer("release_dp_proxy", task, DELAY_TIME);
+    ffrtTimer.SetBlockingTimer("release_dp_proxy", task, DELAY_TIME);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "post delay task end");
 }
 
@@ -127,6 +121,16 @@ bool DevProfile::GetDeviceVersion(const std::string &udid, uint32_t &versionId)
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!udid.empty(), false,
         PASTEBOARD_MODULE_SERVICE, "udid is empty");
 
+    bool cachedVersion = versionCache_.ComputeIfPresent(udid, [&versionId](const auto &key, auto &value) {
+        versionId = value;
+        return true;
+    });
+    if (cachedVersion) {
+        versionCacheHits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    versionCacheMisses_.fetch_add(1, std::memory_order_relaxed);
+
     std::lock_guard lock(proxyMutex_);
     PostDelayReleaseProxy();
     if (proxy_ == nullptr) {
@@ -139,6 +143,7 @@ bool DevProfile::GetDeviceVersion(const std::string &udid, uint32_t &versionId)
         PASTEBOARD_MODULE_SERVICE, "get dp version failed, udid=%{public}.5s", udid.c_str());
 
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "udid=%{public}.5s, version=%{public}u", udid.c_str(), versionId);
+    versionCache_.InsertOrAssign(udid, versionId);
     return true;
 }
 
@@ -226,6 +231,7 @@ void DevProfile::ClearDeviceProfileService()
     PASTEBOARD_CHECK_AND_RETURN_LOGD(proxy_ != nullptr, PASTEBOARD_MODULE_SERVICE, "not need clear");
 
     enabledStatusCache_.Clear();
+    versionCache_.Clear();
     PostDelayReleaseProxy();
     auto adapter = proxy_->GetAdapter();
     PASTEBOARD_CHECK_AND_RETURN_LOGE(adapter != nullptr, PASTEBOARD_MODULE_SERVICE, "adapter is null");
@@ -257,5 +263,18 @@ void DevProfile::EraseEnabledStatus(const std::string &udid)
 {
     enabledStatusCache_.Erase(udid);
 }
+
+void DevProfile::EraseDeviceVersion(const std::string &udid)
+{
+    versionCache_.Erase(udid);
+}
+
+DevProfile::VersionCacheStats DevProfile::GetVersionCacheStats() const
+{
+    VersionCacheStats stats;
+    stats.hits = versionCacheHits_.load(std::memory_order_relaxed);
+    stats.misses = versionCacheMisses_.load(std::memory_order_relaxed);
+    return stats;
+}
 } // namespace MiscServices
 } // namespace OHOS
@@ -134,7 +134,43 @@ uint32_t DistributedModuleConfig::GetRemoteDeviceMaxVersion()
     return maxVersion;
 }
 
+DistributedModuleConfig::VersionStats DistributedModuleConfig::GetVersionStats()
+{
+    std::lock_guard<std::mutex> lock(versionMutex_);
+    return versionStats_;
+}
+
+void DistributedModuleConfig::InvalidateRemoteVersion()
+{
+    std::lock_guard<std::mutex> lock(versionMutex_);
+    versionValid_ = false;
+    ++versionGeneration_;
+}
+
 std::pair<uint32_t, uint32_t> DistributedModuleConfig::GetRemoteDeviceVersion()
+{
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(versionMutex_);
+        if (versionValid_) {
+            ++versionStats_.hits;
+            return remoteVersion_;
+        }
+        generation = versionGeneration_;
+    }
+    bool complete = true;
+    auto version = QueryRemoteDeviceVersion(complete);
+    std::lock_guard<std::mutex> lock(versionMutex_);
+    ++versionStats_.refreshes;
+    // a failed peer query or a peer event during the query makes the result stale, serve it once but do not keep it
+    if (complete && generation == versionGeneration_) {
+        remoteVersion_ = version;
+        versionValid_ = true;
+    }
+    return version;
+}
+
+std::pair<uint32_t, uint32_t> DistributedModuleConfig::QueryRemoteDeviceVersion(bool &complete)
 {
     uint32_t minVersion = UINT_MAX;
     uint32_t maxVersion = 0;
@@ -144,11 +180,13 @@ std::pair<uint32_t, uint32_t> DistributedModuleConfig::GetRemoteDeviceVersion()
         bool remoteEnable = false;
         auto res = DevProfile::GetInstance().GetDeviceStatus(udid, remoteEnable);
         if (res != static_cast<int32_t>(PasteboardError::E_OK) || !remoteEnable) {
+            complete = complete && res == static_cast<int32_t>(PasteboardError::E_OK);
             continue;
         }
 
         uint32_t deviceVersion = 0;
         if (!DevProfile::GetInstance().GetDeviceVersion(udid, deviceVersion)) {
+            complete = false;
             continue;
         }
 
@@ -160,11 +198,14 @@ std::pair<uint32_t, uint32_t> DistributedModuleConfig::GetRemoteDeviceVersion()
 
 void DistributedModuleConfig::Online(const std::string &device)
 {
+    InvalidateRemoteVersion();
     srand(time(nullptr));
     std::this_thread::sleep_for(std::chrono::milliseconds((int32_t(rand() % (RANDOM_MAX - RANDOM_MIN)))));
     DevProfile::GetInstance().SubscribeProfileEvent(device);
     bool remoteEnable = false;
     DevProfile::GetInstance().GetDeviceStatus(device, remoteEnable);
+    // a query during the sleep above may have cached the table without this device
+    InvalidateRemoteVersion();
     Notify();
 }
 
@@ -174,6 +215,8 @@ void DistributedModuleConfig::Offline(const std::string &device)
     std::this_thread::sleep_for(std::chrono::milliseconds((int32_t(rand() % (RANDOM_MAX - RANDOM_MIN)))));
     DevProfile::GetInstance().UnSubscribeProfileEvent(device);
     DevProfile::GetInstance().EraseEnabledStatus(device);
+    DevProfile::GetInstance().EraseDeviceVersion(device);
+    InvalidateRemoteVersion();
     Notify();
 }
 
@@ -186,6 +229,7 @@ void DistributedModuleConfig::Init()
 {
     DMAdapter::GetInstance().Register(this);
     DevProfile::GetInstance().Watch([this](bool isEnable) -> void {
+        InvalidateRemoteVersion();
         Notify();
     });
 }
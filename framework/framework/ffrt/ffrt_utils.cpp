@@ -14,11 +14,76 @@
  */
 
 #include "ffrt/ffrt_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+#include "common/pasteboard_common_utils.h"
 #include "pasteboard_common.h"
 #include "pasteboard_hilog.h"
 
 namespace OHOS {
 namespace MiscServices {
+namespace {
+uint64_t GetSteadyTimeMs()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+// Workers for tasks that may block, so that a fired timer or a fan-out never needs a thread of its own.
+class BlockingTaskPool {
+public:
+    static BlockingTaskPool &GetInstance()
+    {
+        // never destroyed, the workers live as long as the process
+        static BlockingTaskPool *pool = new BlockingTaskPool();
+        return *pool;
+    }
+
+    void Submit(const FFRTTask &task)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+        if (idle_ == 0 && workers_ < MAX_WORKER_NUM) {
+            ++workers_;
+            std::thread thread([this] { Work(); });
+            PasteBoardCommonUtils::SetThreadTaskName(thread, "FFRTTimerWorker");
+            thread.detach();
+        }
+        cond_.notify_one();
+    }
+
+private:
+    static constexpr size_t MAX_WORKER_NUM = 4;
+
+    void Work()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            ++idle_;
+            cond_.wait(lock, [this] { return !tasks_.empty(); });
+            --idle_;
+            FFRTTask task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            task = nullptr;
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<FFRTTask> tasks_;
+    size_t workers_ = 0;
+    size_t idle_ = 0;
+};
+} // namespace
+
 std::unordered_map<std::string, std::shared_ptr<FFRTTimer>> FFRTPool::ffrtPool_;
 std::mutex FFRTPool::mutex_;
 
@@ -37,6 +102,11 @@ void FFRTUtils::SubmitQueueTasks(const std::vector<FFRTTask> &tasks, FFRTQueue &
     }
 }
 
+void FFRTUtils::SubmitBlockingTask(const FFRTTask &task)
+{
+    BlockingTaskPool::GetInstance().Submit(task);
+}
+
 FFRTHandle FFRTUtils::SubmitDelayTask(FFRTTask &task, uint32_t delayMs, FFRTQueue &queue)
 {
     using namespace std::chrono;
@@ -106,15 +176,14 @@ void FFRTTimer::CancelTimer(const std::string &timerId)
 void FFRTTimer::SetTimer(const std::string &timerId, FFRTTask &task, uint32_t delayMs)
 {
     mutex_.lock();
-    CancelTimerInner(timerId);
-    ++taskId_[timerId];
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "Timer[%{public}s] Add Task[%{public}u] with delay = %{public}u",
-        PasteBoardCommon::GetAnonymousString(timerId).c_str(), taskId_[timerId], delayMs);
-    if (delayMs == 0) {
-        FFRTUtils::SubmitTask(task);
-    } else {
-        handleMap_[timerId] = FFRTUtils::SubmitDelayTask(task, delayMs, queue_);
-    }
+    SetTimerInner(timerId, task, delayMs, false);
+    mutex_.unlock();
+}
+
+void FFRTTimer::SetBlockingTimer(const std::string &timerId, const FFRTTask &task, uint32_t delayMs)
+{
+    mutex_.lock();
+    SetTimerInner(timerId, task, delayMs, true);
     mutex_.unlock();
 }
 
@@ -126,7 +195,56 @@ uint32_t FFRTTimer::GetTaskId(const std::string &timerId)
     return id;
 }
 
+FFRTTimer::Stats FFRTTimer::GetStats()
+{
+    mutex_.lock();
+    Stats stats = stats_;
+    stats.pending = 0;
+    for (const auto &p : handleMap_) {
+        stats.pending += (p.second != nullptr) ? 1 : 0;
+    }
+    mutex_.unlock();
+    return stats;
+}
+
+void FFRTTimer::OnTimerFired(const std::string &timerId, uint32_t taskId, uint64_t dueTime)
+{
+    uint64_t now = GetSteadyTimeMs();
+    uint64_t lateness = now > dueTime ? now - dueTime : 0;
+    mutex_.lock();
+    auto iter = taskId_.find(timerId);
+    if (iter != taskId_.end() && iter->second == taskId) {
+        handleMap_.erase(timerId);
+    }
+    ++stats_.fired;
+    stats_.totalLatenessMs += lateness;
+    stats_.maxLatenessMs = std::max(stats_.maxLatenessMs, lateness);
+    mutex_.unlock();
+}
+
 /* inner functions must be called when mutex_ is locked */
+void FFRTTimer::SetTimerInner(const std::string &timerId, const FFRTTask &task, uint32_t delayMs, bool blocking)
+{
+    CancelTimerInner(timerId);
+    uint32_t taskId = ++taskId_[timerId];
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "Timer[%{public}s] Add Task[%{public}u] with delay = %{public}u",
+        PasteBoardCommon::GetAnonymousString(timerId).c_str(), taskId, delayMs);
+    uint64_t dueTime = GetSteadyTimeMs() + delayMs;
+    FFRTTask timerTask = [this, timerId, taskId, dueTime, task, blocking] {
+        OnTimerFired(timerId, taskId, dueTime);
+        if (blocking) {
+            BlockingTaskPool::GetInstance().Submit(task);
+        } else {
+            task();
+        }
+    };
+    if (delayMs == 0) {
+        FFRTUtils::SubmitTask(timerTask);
+    } else {
+        handleMap_[timerId] = FFRTUtils::SubmitDelayTask(timerTask, delayMs, queue_);
+    }
+}
+
 void FFRTTimer::CancelAllTimerInner()
 {
     for (auto &p : handleMap_) {
@@ -134,6 +252,7 @@ void FFRTTimer::CancelAllTimerInner()
             PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "Timer[%{public}s] Cancel Task[%{public}u]",
                 PasteBoardCommon::GetAnonymousString(p.first).c_str(), taskId_[p.first]);
             FFRTUtils::CancelTask(p.second, queue_);
+            p.second = nullptr;
         }
     }
 }
@@ -27,8 +27,13 @@ class API_EXPORT ClipPlugin {
 public:
     enum EventStatus : uint32_t { EVT_UNKNOWN, EVT_INVALID, EVT_NORMAL, EVT_BUTT };
     enum ServiceStatus : uint32_t { UNKNOWN = 0, IDLE, CONNECT_SUCC };
-    enum InfoType : uint8_t { DEFAULT = 0, DELAY_DATA = 1, MIMETYPE = 2};
+    enum InfoType : uint8_t { DEFAULT = 0, DELAY_DATA = 1, MIMETYPE = 2, TYPE_INDEX = 3 };
+    // A type frame is the mimeTypes payload of SetPasteData/GetMimeTypes for peers of VERSION_SEVEN and later:
+    // TYPE_FRAME_HEAD then the TLV of the record type index and sizes. A MIMETYPE reader would take the head
+    // for an oversized length and find no types, so older peers still get the plain mimeTypes list.
+    static constexpr uint8_t TYPE_FRAME_HEAD[] = { 0xFF, 0xFF, 0x01 };
 
+    // Sent to peers through GlobalEventCodec, which keeps the JSON form for peers before VERSION_SEVEN.
     struct GlobalEvent final : public DistributedData::Serializable {
         uint8_t version = 0;
         uint8_t frameNum = 0;
@@ -67,6 +72,7 @@ public:
     static bool RegCreator(const std::string &name, Factory *factory);
     static ClipPlugin *CreatePlugin(const std::string &name);
     static bool DestroyPlugin(const std::string &name, ClipPlugin *plugin);
+    static bool IsTypeFrame(const std::vector<uint8_t> &mimeTypes);
 
     virtual ~ClipPlugin() = default;
     virtual int32_t SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data, uint32_t version,
@@ -80,6 +86,10 @@ public:
     virtual void Clear(int32_t user);
     virtual int32_t Close(int32_t user);
     virtual void RegisterDelayCallback(const DelayDataCallback &dataCallback, const DelayEntryCallback &entryCallback);
+    // Chunked clips of VERSION_SEVEN peers ride on this call: SetPasteData gets the first TLVChunkWriter frame and
+    // the receiver pulls the rest with utdId "openharmony.pasteboard-chunk" and the frame index as recordId, which
+    // may be past the record count. A plugin passes both to the sender's DelayEntryCallback and the bytes back
+    // unchanged, without checking either against the clip.
     virtual int32_t GetPasteDataEntry(const GlobalEvent &event, uint32_t recordId, const std::string &utdId,
         std::vector<uint8_t> &rawData);
     virtual void ChangeStoreStatus(int32_t userId);
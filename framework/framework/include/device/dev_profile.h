@@ -20,6 +20,7 @@
 #include "common/concurrent_map.h"
 #include "ffrt.h"
 
+#include <atomic>
 #include <memory>
 #include <unordered_set>
 
@@ -30,6 +31,10 @@ class DeviceProfileProxy;
 class API_EXPORT DevProfile {
 public:
     using Observer = std::function<void(bool isEnable)>;
+    struct VersionCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
     static DevProfile &GetInstance();
     int32_t GetDeviceStatus(const std::string &udid, bool &status);
     void PutDeviceStatus(bool status);
@@ -42,6 +47,8 @@ public:
     void Watch(Observer observer);
     void UpdateEnabledStatus(const std::string &udid, bool status);
     void EraseEnabledStatus(const std::string &udid);
+    void EraseDeviceVersion(const std::string &udid);
+    VersionCacheStats GetVersionCacheStats() const;
 
 private:
     DevProfile() = default;
@@ -52,6 +59,10 @@ private:
 
     Observer observer_ = nullptr;
     ConcurrentMap<std::string, bool> enabledStatusCache_;
+    // A peer only changes its version across a reboot, which takes it offline, so entries live until Offline.
+    ConcurrentMap<std::string, uint32_t> versionCache_;
+    std::atomic<uint64_t> versionCacheHits_ = 0;
+    std::atomic<uint64_t> versionCacheMisses_ = 0;
     std::shared_ptr<DeviceProfileProxy> proxy_ = nullptr;
     ffrt::recursive_mutex proxyMutex_;
     std::unordered_set<std::string> subscribeUdidList_;
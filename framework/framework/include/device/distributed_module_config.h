@@ -18,6 +18,7 @@
 
 #include "device/dm_adapter.h"
 #include <atomic>
+#include <mutex>
 
 namespace OHOS {
 namespace MiscServices {
@@ -31,12 +32,18 @@ public:
     void DeInit();
     uint32_t GetRemoteDeviceMinVersion();
     uint32_t GetRemoteDeviceMaxVersion();
+    struct VersionStats {
+        uint64_t hits = 0;
+        uint64_t refreshes = 0;
+    };
+    VersionStats GetVersionStats();
     static constexpr uint32_t FIRST_VERSION = 4;
     static constexpr uint32_t SECOND_VERSION = 5;
     enum Version : uint32_t {
         VERSION_FOUR = 4,
         VERSION_FIVE = 5,
         VERSION_SIX = 6,
+        VERSION_SEVEN = 7, // decodes the type frame, the binary GlobalEvent and chunked clips
         VERSION_DEFAULT,
     };
 
@@ -47,6 +54,8 @@ protected:
 
 private:
     std::pair<uint32_t, uint32_t> GetRemoteDeviceVersion();
+    std::pair<uint32_t, uint32_t> QueryRemoteDeviceVersion(bool &complete);
+    void InvalidateRemoteVersion();
     int32_t GetEnabledStatus();
     void Notify();
     void GetRetryTask();
@@ -55,6 +64,14 @@ private:
     std::atomic<bool> status_;
     std::atomic<bool> retrying_;
     static constexpr const char *SUPPORT_STATUS = "1";
+
+    // (min, max) version of the enabled peers, rebuilt on first use after Online, Offline or a profile update,
+    // and only kept when every peer answered.
+    std::mutex versionMutex_;
+    bool versionValid_ = false;
+    uint64_t versionGeneration_ = 0;
+    std::pair<uint32_t, uint32_t> remoteVersion_;
+    VersionStats versionStats_;
 };
 } // namespace MiscServices
 } // namespace OHOS
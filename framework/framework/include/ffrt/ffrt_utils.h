@@ -58,6 +58,15 @@ public:
  */
     static void SubmitQueueTasks(const std::vector<FFRTTask> &tasks, FFRTQueue &queue);
 
+    /**
+ * Submit a task that may block on locks or remote calls without blocking the current thread.
+ * <p>
+ * The task runs on the small worker pool shared with blocking timers instead of an FFRT worker.
+ *
+ * @param task FFRT task.
+ */
+    static void SubmitBlockingTask(const FFRTTask &task);
+
     /**
  * Submit the FFRT delayed task without blocking the current thread.
  * <p>
@@ -118,6 +127,13 @@ public:
 
 class API_EXPORT FFRTTimer {
 public:
+    struct Stats {
+        size_t pending = 0;
+        uint64_t fired = 0;
+        uint64_t totalLatenessMs = 0;
+        uint64_t maxLatenessMs = 0;
+    };
+
     FFRTTimer();
     FFRTTimer(const std::string &timerName);
     ~FFRTTimer();
@@ -125,17 +141,25 @@ public:
     void CancelAllTimer();
     void CancelTimer(const std::string &timerId);
     void SetTimer(const std::string &timerId, FFRTTask &task, uint32_t delayMs = 0);
+
+    // Same as SetTimer, for tasks that may block on locks or remote calls; runs them on the shared worker pool.
+    void SetBlockingTimer(const std::string &timerId, const FFRTTask &task, uint32_t delayMs = 0);
     uint32_t GetTaskId(const std::string &timerId);
+    Stats GetStats();
 
 private:
     /* inner functions must be called when mutex_ is locked */
     void CancelAllTimerInner();
     void CancelTimerInner(const std::string &timerId);
+    void SetTimerInner(const std::string &timerId, const FFRTTask &task, uint32_t delayMs, bool blocking);
+    void OnTimerFired(const std::string &timerId, uint32_t taskId, uint64_t dueTime);
 
     FFRTMutex mutex_;
-    FFRTQueue queue_;
     std::unordered_map<std::string, FFRTHandle> handleMap_;
     std::unordered_map<std::string, uint32_t> taskId_;
+    Stats stats_;
+    // declared last, so running tasks are done before the members above are destroyed
+    FFRTQueue queue_;
 };
 
 class API_EXPORT FFRTPool {
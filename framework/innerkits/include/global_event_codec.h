@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTEDDATAMGR_PASTEBOARD_GLOBAL_EVENT_CODEC_H
+#define DISTRIBUTEDDATAMGR_PASTEBOARD_GLOBAL_EVENT_CODEC_H
+
+#include <cstdint>
+#include <vector>
+
+#include "api/visibility.h"
+#include "clip/clip_plugin.h"
+
+namespace OHOS::MiscServices {
+/*
+ * Wire codec of ClipPlugin::GlobalEvent for the top event sync and presync. Peers of
+ * DistributedModuleConfig::VERSION_SEVEN and later get a TLV frame led by its codec version, older peers the
+ * Serializable JSON. Decode tells the two apart by the first tag, so a receiver takes both during an upgrade.
+ * Fields are only ever added under new tags, CODEC_VERSION grows when an existing tag changes its meaning.
+ */
+class API_EXPORT GlobalEventCodec {
+public:
+    static constexpr uint32_t CODEC_VERSION = 1;
+
+    static bool Encode(const ClipPlugin::GlobalEvent &event, uint32_t peerVersion, std::vector<uint8_t> &buffer);
+    static bool Decode(const std::vector<uint8_t> &buffer, ClipPlugin::GlobalEvent &event);
+    static bool IsBinary(const std::vector<uint8_t> &buffer);
+};
+} // namespace OHOS::MiscServices
+#endif // DISTRIBUTEDDATAMGR_PASTEBOARD_GLOBAL_EVENT_CODEC_H
@@ -15,6 +15,9 @@
 #ifndef PASTE_BOARD_DATA_H
 #define PASTE_BOARD_DATA_H
 
+#include <functional>
+#include <mutex>
+
 #include "paste_data_record.h"
 #include "pasteboard_event_common.h"
 
@@ -45,6 +48,19 @@ struct API_EXPORT PasteDataProperty : public TLVWriteable, public TLVReadable {
     size_t CountTLV() const override;
 };
 
+// Sorted type lists of all records, built once when the clip is stored and carried through the TLV.
+struct API_EXPORT PasteDataTypeIndex : public TLVWriteable, public TLVReadable {
+    std::vector<std::string> mimeTypes; // same as PasteData::GetMimeTypes
+    std::vector<std::string> allMimeTypes;
+    std::vector<std::string> utdTypes;
+    std::vector<int64_t> recordSizes; // encoded size of each record, only filled for the distributed type frame
+
+    static bool Contains(const std::vector<std::string> &types, const std::string &type);
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override;
+    bool DecodeTLV(ReadOnlyBuffer &buffer) override;
+    size_t CountTLV() const override;
+};
+
 class API_EXPORT PasteData : public TLVWriteable, public TLVReadable, public Parcelable {
 public:
     static constexpr const std::uint32_t MAX_RECORD_NUM = 512;
@@ -74,12 +90,23 @@ public:
     std::shared_ptr<OHOS::AAFwk::Want> GetPrimaryWant();
     std::shared_ptr<PasteDataRecord> GetRecordAt(std::size_t index) const;
     std::shared_ptr<PasteDataRecord> GetRecordById(uint32_t recordId) const;
+    // Same records as above but the type index is kept, for callers that never add or remove entry types.
+    std::shared_ptr<PasteDataRecord> PeekRecordAt(std::size_t index) const;
+    std::shared_ptr<PasteDataRecord> PeekRecordById(uint32_t recordId) const;
+    std::vector<std::shared_ptr<PasteDataRecord>> PeekRecords() const;
     std::size_t GetRecordCount() const;
     bool RemoveRecordAt(std::size_t number);
     bool ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRecord> record);
+    // Records are shared with data; call MutableRecordAt before changing one of them.
+    void ShareFrom(const PasteData &data);
+    std::shared_ptr<PasteDataRecord> MutableRecordAt(std::size_t index);
+    void UnshareRecords();
     void RemoveEmptyEntry();
     bool HasMimeType(const std::string &mimeType);
     bool HasUtdType(const std::string &utdType);
+    bool HasListedMimeType(const std::string &mimeType);
+    void BuildTypeIndex();
+    std::shared_ptr<const PasteDataTypeIndex> GetTypeIndex() const;
     PasteDataProperty GetProperty() const;
     void SetProperty(const PasteDataProperty &property);
     ShareOption GetShareOption();
@@ -118,6 +145,20 @@ public:
     bool EncodeTLV(WriteOnlyBuffer &buffer) const override;
     bool DecodeTLV(ReadOnlyBuffer &buffer) override;
     size_t CountTLV() const override;
+    /*
+     * Split encoding: EncodeRecords() emits only the records section and EncodeWithoutRecords() emits the
+     * remaining fields. Concatenating both decodes to the same PasteData as Encode().
+     */
+    bool EncodeRecords(std::vector<uint8_t> &buffer) const;
+    bool EncodeWithoutRecords(std::vector<uint8_t> &buffer) const;
+    /*
+     * Lazy decoding: only the record boundaries are indexed here and each record is decoded on first
+     * access. The raw pointer overload copies the bytes, the shared one keeps data alive without copying.
+     */
+    bool DecodeLazily(const uint8_t *data, size_t size);
+    bool DecodeLazily(std::shared_ptr<const uint8_t> data, size_t size);
+    // Applies visitor to every record, records still pending a lazy decode are visited once loaded.
+    void VisitRecords(const std::function<void(PasteDataRecord &)> &visitor);
 
     bool IsValid() const;
     void SetInvalid();
@@ -171,12 +212,40 @@ private:
     uint32_t dataId_ = 0;
     uint32_t recordId_ = 0;
     size_t textSize_ = 0;
+    struct LazyRecord {
+        size_t offset = 0;
+        uint32_t length = 0;
+        bool loaded = true;
+    };
     PasteDataProperty props_;
-    std::vector<std::shared_ptr<PasteDataRecord>> records_;
+    // Entries are null while their LazyRecord is not loaded yet.
+    mutable std::vector<std::shared_ptr<PasteDataRecord>> records_;
+    mutable std::vector<LazyRecord> lazyRecords_;
+    mutable std::shared_ptr<const uint8_t> lazyBuffer_;
+    mutable std::vector<std::function<void(PasteDataRecord &)>> lazyVisitors_;
+    mutable std::mutex lazyMutex_;
+    // Dropped whenever records are added, removed or handed out for writing.
+    mutable std::shared_ptr<const PasteDataTypeIndex> typeIndex_;
+    mutable std::mutex typeIndexMutex_;
     std::pair<std::string, int32_t> originAuthority_;
     std::string pasteId_;
  
     void RefreshMimeProp();
+    bool DecodeFieldsTLV(ReadOnlyBuffer &buffer, bool lazy);
+    bool IndexRecordsTLV(ReadOnlyBuffer &buffer, const TLVHead &head);
+    bool EncodeRecordsTLV(WriteOnlyBuffer &buffer) const;
+    size_t CountRecordsTLV() const;
+    size_t CountRecordItems() const;
+    bool EncodeAttributesTLV(WriteOnlyBuffer &buffer) const;
+    size_t CountAttributesTLV() const;
+    void AssignFrom(const PasteData &data, bool shareRecords);
+    void CopyRecords(const PasteData &data, bool shareRecords = false);
+    std::shared_ptr<PasteDataRecord> LoadRecord(size_t index) const;
+    std::shared_ptr<PasteDataRecord> LoadRecordLocked(size_t index) const;
+    void LoadAllRecords() const;
+    void LoadAllRecordsLocked() const;
+    void SetTypeIndex(std::shared_ptr<const PasteDataTypeIndex> typeIndex);
+    void DropTypeIndex() const;
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -16,19 +16,33 @@
 #ifndef PASTEBOARD_IMG_EXTRACTOR_H
 #define PASTEBOARD_IMG_EXTRACTOR_H
 
-#include <libxml/HTMLparser.h>
-#include <libxml/xpath.h>
-#include <mutex>
+#include <cstdint>
 #include <string>
+#include <sys/types.h>
+#include <utility>
 #include <vector>
 
 namespace OHOS {
 namespace MiscServices {
 class PasteboardImgExtractor {
 public:
+    struct ImgTag {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        // src values with their offsets in the scanned html
+        std::vector<std::pair<std::string, uint32_t>> srcs;
+    };
+
     static PasteboardImgExtractor &GetInstance();
     std::vector<std::string> ExtractImgSrc(const std::string &htmlContent, const std::string &bundleIndex,
         int32_t userId);
+    // Finds <img ...> tags and their src values in one pass, skipping comments, attribute values and the
+    // content of script, style, textarea and title. Tag and attribute names are matched case-insensitively.
+    static std::vector<ImgTag> ScanImgTags(const std::string &html);
+    static std::vector<std::pair<std::string, uint32_t>> ScanImgSrcs(const std::string &tag, uint32_t tagOffset);
+    // Keeps the local image uris that exist in the sandbox of bundleIndex.
+    static std::vector<std::string> FilterValidImgSrc(std::vector<std::string> uris, const std::string &bundleIndex,
+        int32_t userId);
 
     static constexpr const char *IMG_LOCAL_URI = "file:///";
     static constexpr const char *FILE_SCHEME_PREFIX = "file://";
@@ -36,17 +50,16 @@ public:
     static constexpr const char *DOC_URI_PREFIX = "file://docs/";
 
 private:
-    PasteboardImgExtractor();
-    ~PasteboardImgExtractor();
+    PasteboardImgExtractor() = default;
+    ~PasteboardImgExtractor() = default;
     static void FilterFileUris(std::vector<std::string> &uris);
     static void FilterImgUris(std::vector<std::string> &uris);
     static void FilterExistFileUris(std::vector<std::string> &uris, const std::string &bundleIndex, int32_t userId);
+    static bool IsExistFileUri(const std::string &uriStr, const std::string &bundleIndex,
+        const std::string &userIdStr, uid_t callingUid);
     static bool MatchImgExtension(const std::string &uri);
-    std::vector<std::string> FindImgsExcludingSpan(xmlDocPtr doc);
-    std::vector<std::string> ExecuteXPath(xmlDocPtr doc, const char *xpathExpr);
-    std::string SafeXmlToString(const xmlChar *xmlStr);
-
-    std::mutex mutex_;
+    static size_t FindTagEnd(const std::string &html, size_t pos);
+    static size_t SkipRawText(const std::string &html, size_t pos);
 };
 } // namespace MiscServices
 } // namespace OHOS
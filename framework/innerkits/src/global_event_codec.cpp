@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "global_event_codec.h"
+
+#include "device/distributed_module_config.h"
+#include "pasteboard_hilog.h"
+#include "tlv_readable.h"
+#include "tlv_writeable.h"
+
+namespace OHOS::MiscServices {
+namespace {
+enum TAG_GLOBAL_EVENT : uint16_t {
+    TAG_EVENT_CODEC_VERSION = TAG_BUFF + 1,
+    TAG_EVENT_VERSION,
+    TAG_EVENT_FRAME_NUM,
+    TAG_EVENT_USER,
+    TAG_EVENT_SEQ_ID,
+    TAG_EVENT_STATUS,
+    TAG_EVENT_SYNC_TIME,
+    TAG_EVENT_DATA_ID,
+    TAG_EVENT_EXPIRATION,
+    TAG_EVENT_IS_DELAY,
+    TAG_EVENT_NOT_NEED_LINK,
+    TAG_EVENT_DEVICE_ID,
+    TAG_EVENT_ACCOUNT,
+    TAG_EVENT_DATA_TYPE,
+};
+
+// Unsigned fields travel as the signed TLV type of the same width.
+class GlobalEventWriter final : public TLVWriteable {
+public:
+    explicit GlobalEventWriter(const ClipPlugin::GlobalEvent &event) : event_(event) {}
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        bool ret = buffer.Write(TAG_EVENT_CODEC_VERSION, GlobalEventCodec::CODEC_VERSION);
+        ret = ret && buffer.Write(TAG_EVENT_VERSION, static_cast<int8_t>(event_.version));
+        ret = ret && buffer.Write(TAG_EVENT_FRAME_NUM, static_cast<int8_t>(event_.frameNum));
+        ret = ret && buffer.Write(TAG_EVENT_USER, static_cast<int16_t>(event_.user));
+        ret = ret && buffer.Write(TAG_EVENT_SEQ_ID, static_cast<int16_t>(event_.seqId));
+        ret = ret && buffer.Write(TAG_EVENT_STATUS, static_cast<int16_t>(event_.status));
+        ret = ret && buffer.Write(TAG_EVENT_SYNC_TIME, event_.syncTime);
+        ret = ret && buffer.Write(TAG_EVENT_DATA_ID, event_.dataId);
+        ret = ret && buffer.Write(TAG_EVENT_EXPIRATION, static_cast<int64_t>(event_.expiration));
+        ret = ret && buffer.Write(TAG_EVENT_IS_DELAY, event_.isDelay);
+        ret = ret && buffer.Write(TAG_EVENT_NOT_NEED_LINK, event_.notNeedLink);
+        ret = ret && buffer.Write(TAG_EVENT_DEVICE_ID, event_.deviceId);
+        ret = ret && buffer.Write(TAG_EVENT_ACCOUNT, event_.account);
+        ret = ret && buffer.Write(TAG_EVENT_DATA_TYPE, event_.dataType);
+        return ret;
+    }
+
+    size_t CountTLV() const override
+    {
+        size_t expectedSize = 0;
+        expectedSize += TLVCountable::Count(GlobalEventCodec::CODEC_VERSION);
+        expectedSize += TLVCountable::Count(static_cast<int8_t>(event_.version));
+        expectedSize += TLVCountable::Count(static_cast<int8_t>(event_.frameNum));
+        expectedSize += TLVCountable::Count(static_cast<int16_t>(event_.user));
+        expectedSize += TLVCountable::Count(static_cast<int16_t>(event_.seqId));
+        expectedSize += TLVCountable::Count(static_cast<int16_t>(event_.status));
+        expectedSize += TLVCountable::Count(event_.syncTime);
+        expectedSize += TLVCountable::Count(event_.dataId);
+        expectedSize += TLVCountable::Count(static_cast<int64_t>(event_.expiration));
+        expectedSize += TLVCountable::Count(event_.isDelay);
+        expectedSize += TLVCountable::Count(event_.notNeedLink);
+        expectedSize += TLVCountable::Count(event_.deviceId);
+        expectedSize += TLVCountable::Count(event_.account);
+        expectedSize += TLVCountable::Count(event_.dataType);
+        return expectedSize;
+    }
+
+private:
+    const ClipPlugin::GlobalEvent &event_;
+};
+
+class GlobalEventReader final : public TLVReadable {
+public:
+    explicit GlobalEventReader(ClipPlugin::GlobalEvent &event) : event_(event) {}
+
+    // Tags added by a newer peer under the same codec version are skipped.
+    bool DecodeTLV(ReadOnlyBuffer &buffer) override
+    {
+        TLVHead head{};
+        uint32_t codecVersion = 0;
+        bool ret = buffer.ReadHead(head) && head.tag == TAG_EVENT_CODEC_VERSION &&
+            buffer.ReadValue(codecVersion, head);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON, "read codec version failed");
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(codecVersion != 0 && codecVersion <= GlobalEventCodec::CODEC_VERSION,
+            false, PASTEBOARD_MODULE_COMMON, "codec version unsupported, version=%{public}u, local=%{public}u",
+            codecVersion, GlobalEventCodec::CODEC_VERSION);
+        for (; buffer.IsEnough();) {
+            ret = buffer.ReadHead(head) && ReadField(buffer, head);
+            PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON,
+                "read value failed, tag=%{public}hu, len=%{public}u", head.tag, head.len);
+        }
+        return true;
+    }
+
+private:
+    bool ReadField(ReadOnlyBuffer &buffer, const TLVHead &head)
+    {
+        switch (head.tag) {
+            case TAG_EVENT_VERSION:
+                return ReadAs<int8_t>(buffer, head, event_.version);
+            case TAG_EVENT_FRAME_NUM:
+                return ReadAs<int8_t>(buffer, head, event_.frameNum);
+            case TAG_EVENT_USER:
+                return ReadAs<int16_t>(buffer, head, event_.user);
+            case TAG_EVENT_SEQ_ID:
+                return ReadAs<int16_t>(buffer, head, event_.seqId);
+            case TAG_EVENT_STATUS:
+                return ReadAs<int16_t>(buffer, head, event_.status);
+            case TAG_EVENT_SYNC_TIME:
+                return buffer.ReadValue(event_.syncTime, head);
+            case TAG_EVENT_DATA_ID:
+                return buffer.ReadValue(event_.dataId, head);
+            case TAG_EVENT_EXPIRATION:
+                return ReadAs<int64_t>(buffer, head, event_.expiration);
+            case TAG_EVENT_IS_DELAY:
+                return buffer.ReadValue(event_.isDelay, head);
+            case TAG_EVENT_NOT_NEED_LINK:
+                return buffer.ReadValue(event_.notNeedLink, head);
+            case TAG_EVENT_DEVICE_ID:
+                return buffer.ReadValue(event_.deviceId, head);
+            case TAG_EVENT_ACCOUNT:
+                return buffer.ReadValue(event_.account, head);
+            case TAG_EVENT_DATA_TYPE:
+                event_.dataType.clear();
+                return buffer.ReadValue(event_.dataType, head);
+            default:
+                return buffer.Skip(head.len);
+        }
+    }
+
+    template<typename Wire, typename T>
+    static bool ReadAs(ReadOnlyBuffer &buffer, const TLVHead &head, T &value)
+    {
+        Wire wire = 0;
+        if (!buffer.ReadValue(wire, head)) {
+            return false;
+        }
+        value = static_cast<T>(wire);
+        return true;
+    }
+
+    ClipPlugin::GlobalEvent &event_;
+};
+} // namespace
+
+bool GlobalEventCodec::Encode(const ClipPlugin::GlobalEvent &event, uint32_t peerVersion,
+    std::vector<uint8_t> &buffer)
+{
+    if (peerVersion < DistributedModuleConfig::Version::VERSION_SEVEN) {
+        auto json = event.Marshall();
+        buffer.assign(json.begin(), json.end());
+        return !json.empty();
+    }
+    return GlobalEventWriter(event).Encode(buffer);
+}
+
+bool GlobalEventCodec::Decode(const std::vector<uint8_t> &buffer, ClipPlugin::GlobalEvent &event)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!buffer.empty(), false, PASTEBOARD_MODULE_COMMON, "buffer is empty");
+    if (!IsBinary(buffer)) {
+        return event.Unmarshall(std::string(buffer.begin(), buffer.end()));
+    }
+    GlobalEventReader reader(event);
+    return reader.Decode(buffer);
+}
+
+bool GlobalEventCodec::IsBinary(const std::vector<uint8_t> &buffer)
+{
+    TLVHead head{};
+    if (buffer.size() < sizeof(head) || memcpy_s(&head, sizeof(head), buffer.data(), sizeof(head)) != EOK) {
+        return false;
+    }
+    return NetToHost(head.tag) == TAG_EVENT_CODEC_VERSION;
+}
+} // namespace OHOS::MiscServices
@@ -16,6 +16,9 @@
 
 #include "paste_data.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "int_wrapper.h"
 #include "ipc_skeleton.h"
 #include "long_wrapper.h"
@@ -39,6 +42,13 @@ enum TAG_PASTEBOARD : uint16_t {
     TAG_DATA_ID,
     TAG_RECORD_ID,
     TAG_USER_ID,
+    TAG_TYPE_INDEX,
+};
+enum TAG_TYPE_INDEX_ITEM : uint16_t {
+    TAG_INDEX_MIME_TYPES = TAG_BUFF + 1,
+    TAG_INDEX_ALL_MIME_TYPES,
+    TAG_INDEX_UTD_TYPES,
+    TAG_INDEX_RECORD_SIZES,
 };
 enum TAG_PROPERTY : uint16_t {
     TAG_ADDITIONS = TAG_BUFF + 1,
@@ -62,6 +72,31 @@ const char *ORIGIN_INFO = "originInfo";
 
 constexpr int32_t PARCEL_MAX_CAPACITY = 500 * 1024;
 
+namespace {
+// Encodes a subset of the PasteData fields as a standalone TLV stream.
+class TLVSection : public TLVWriteable {
+public:
+    TLVSection(std::function<bool(WriteOnlyBuffer &)> encoder, std::function<size_t()> counter)
+        : encoder_(std::move(encoder)), counter_(std::move(counter))
+    {
+    }
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        return encoder_(buffer);
+    }
+
+    size_t CountTLV() const override
+    {
+        return counter_();
+    }
+
+private:
+    std::function<bool(WriteOnlyBuffer &)> encoder_;
+    std::function<size_t()> counter_;
+};
+} // namespace
+
 PasteData::PasteData()
 { // LCOV_EXCL_START
     props_.timestamp = steady_clock::now().time_since_epoch().count();
@@ -81,13 +116,8 @@ PasteData::PasteData(const PasteData &data)
       textSize_(data.textSize_), originAuthority_(data.originAuthority_), pasteId_(data.pasteId_)
 { // LCOV_EXCL_START
     this->props_ = data.props_;
-    for (const auto &item : data.records_) {
-        if (item == nullptr) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
-            continue;
-        }
-        this->records_.emplace_back(std::make_shared<PasteDataRecord>(*item));
-    }
+    CopyRecords(data);
+    typeIndex_ = data.GetTypeIndex();
 } // LCOV_EXCL_STOP
 
 PasteData::PasteData(std::vector<std::shared_ptr<PasteDataRecord>> records) : records_{ std::move(records) }
@@ -107,6 +137,20 @@ PasteData &PasteData::operator=(const PasteData &data)
     if (this == &data) {
         return *this;
     }
+    AssignFrom(data, false);
+    return *this;
+} // LCOV_EXCL_STOP
+
+void PasteData::ShareFrom(const PasteData &data)
+{
+    if (this == &data) {
+        return;
+    }
+    AssignFrom(data, true);
+}
+
+void PasteData::AssignFrom(const PasteData &data, bool shareRecords)
+{
     this->originAuthority_ = data.originAuthority_;
     this->valid_ = data.valid_;
     this->isDraggedData_ = data.isDraggedData_;
@@ -115,22 +159,40 @@ PasteData &PasteData::operator=(const PasteData &data)
     this->isDelayRecord_ = data.isDelayRecord_;
     this->dataId_ = data.dataId_;
     this->props_ = data.props_;
-    this->records_.clear();
     this->deviceId_ = data.deviceId_;
     this->pasteId_ = data.pasteId_;
-    for (const auto &item : data.records_) {
-        if (item == nullptr) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
-            continue;
-        }
-        this->records_.emplace_back(std::make_shared<PasteDataRecord>(*item));
-    }
+    CopyRecords(data, shareRecords);
+    SetTypeIndex(data.GetTypeIndex());
     this->recordId_ = data.GetRecordId();
     this->textSize_ = data.textSize_;
     this->rawDataSize_ = data.rawDataSize_;
     this->userId_ = data.userId_;
-    return *this;
-} // LCOV_EXCL_STOP
+}
+
+void PasteData::CopyRecords(const PasteData &data, bool shareRecords)
+{
+    std::lock_guard<std::mutex> lock(data.lazyMutex_);
+    records_.clear();
+    lazyRecords_.clear();
+    lazyBuffer_ = data.lazyBuffer_;
+    lazyVisitors_ = data.lazyVisitors_;
+    for (size_t i = 0; i < data.records_.size(); ++i) {
+        const auto &item = data.records_[i];
+        bool pending = lazyBuffer_ != nullptr && !data.lazyRecords_[i].loaded;
+        if (item == nullptr && !pending) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
+            continue;
+        }
+        if (pending) {
+            records_.emplace_back(nullptr);
+        } else {
+            records_.emplace_back(shareRecords ? item : std::make_shared<PasteDataRecord>(*item));
+        }
+        if (lazyBuffer_ != nullptr) {
+            lazyRecords_.emplace_back(data.lazyRecords_[i]);
+        }
+    }
+}
 
 PasteDataProperty PasteData::GetProperty() const
 { // LCOV_EXCL_START
@@ -176,6 +238,8 @@ void PasteData::AddRecord(std::shared_ptr<PasteDataRecord> record)
 { // LCOV_EXCL_START
     PASTEBOARD_CHECK_AND_RETURN_LOGE(record != nullptr, PASTEBOARD_MODULE_CLIENT, "record is null");
     record->SetRecordId(++recordId_);
+    LoadAllRecords();
+    SetTypeIndex(nullptr);
 
     if (PasteBoardCommon::IsPasteboardService()) {
         props_.mimeTypes.emplace_back(record->GetMimeType());
@@ -193,6 +257,11 @@ void PasteData::AddRecord(const PasteDataRecord &record)
 
 std::vector<std::string> PasteData::GetMimeTypes()
 { // LCOV_EXCL_START
+    auto typeIndex = GetTypeIndex();
+    if (typeIndex != nullptr) {
+        return typeIndex->mimeTypes;
+    }
+    LoadAllRecords();
     std::set<std::string> mimeTypes;
     for (const auto &item : records_) {
         if (item->GetFrom() > 0 && item->GetRecordId() != item->GetFrom()) {
@@ -207,10 +276,10 @@ std::vector<std::string> PasteData::GetMimeTypes()
 std::vector<std::string> PasteData::GetReportMimeTypes()
 { // LCOV_EXCL_START
     std::vector<std::string> mimeTypes;
-    uint32_t recordNum = records_.size();
+    uint32_t recordNum = GetRecordCount();
     uint32_t maxReportNum = recordNum > MAX_REPORT_RECORD_NUM ? MAX_REPORT_RECORD_NUM : recordNum;
     for (uint32_t i = 0; i < maxReportNum; ++i) {
-        auto &item = records_[i];
+        auto item = LoadRecord(i);
         if (item == nullptr) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is nullptr.");
             mimeTypes.emplace_back("NULL");
@@ -256,10 +325,10 @@ uint8_t PasteData::GenerateDataType()
 DataDescription PasteData::GetReportDescription()
 { // LCOV_EXCL_START
     DataDescription description;
-    description.recordNum = records_.size();
+    description.recordNum = GetRecordCount();
     description.mimeTypes = GetReportMimeTypes();
     for (uint32_t i = 0; i < description.recordNum; i++) {
-        auto record = GetRecordAt(i);
+        auto record = LoadRecord(i);
         if (record == nullptr) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "GetRecordAt(%{public}u) failed.", i);
             description.entryNum.push_back(-1);
@@ -273,7 +342,11 @@ DataDescription PasteData::GetReportDescription()
 
 std::shared_ptr<std::string> PasteData::GetPrimaryHtml()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto item = LoadRecord(i);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<std::string> primary = item->GetHtmlText();
         if (primary) {
             return primary;
@@ -284,7 +357,11 @@ std::shared_ptr<std::string> PasteData::GetPrimaryHtml()
 
 std::shared_ptr<PixelMap> PasteData::GetPrimaryPixelMap()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto item = LoadRecord(i);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<PixelMap> primary = item->GetPixelMap();
         if (primary) {
             return primary;
@@ -295,7 +372,11 @@ std::shared_ptr<PixelMap> PasteData::GetPrimaryPixelMap()
 
 std::shared_ptr<OHOS::AAFwk::Want> PasteData::GetPrimaryWant()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto item = LoadRecord(i);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<OHOS::AAFwk::Want> primary = item->GetWant();
         if (primary) {
             return primary;
@@ -306,7 +387,11 @@ std::shared_ptr<OHOS::AAFwk::Want> PasteData::GetPrimaryWant()
 
 std::shared_ptr<std::string> PasteData::GetPrimaryText()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto item = LoadRecord(i);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<std::string> primary = item->GetPlainText();
         if (primary) {
             return primary;
@@ -317,7 +402,11 @@ std::shared_ptr<std::string> PasteData::GetPrimaryText()
 
 std::shared_ptr<OHOS::Uri> PasteData::GetPrimaryUri()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto item = LoadRecord(i);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<OHOS::Uri> primary = item->GetUri();
         if (primary) {
             return primary;
@@ -328,33 +417,71 @@ std::shared_ptr<OHOS::Uri> PasteData::GetPrimaryUri()
 
 std::shared_ptr<std::string> PasteData::GetPrimaryMimeType()
 { // LCOV_EXCL_START
-    if (records_.empty()) {
+    auto record = LoadRecord(0);
+    if (record == nullptr) {
         return nullptr;
     }
-    return std::make_shared<std::string>(records_.front()->GetMimeType());
+    return std::make_shared<std::string>(record->GetMimeType());
 } // LCOV_EXCL_STOP
 
 std::shared_ptr<PasteDataRecord> PasteData::GetRecordAt(std::size_t index) const
 { // LCOV_EXCL_START
-    if (records_.size() > index) {
-        return records_[index];
-    } else {
-        return nullptr;
-    }
+    // the caller may change the record, so the index can no longer be trusted
+    DropTypeIndex();
+    return LoadRecord(index);
 } // LCOV_EXCL_STOP
 
+std::shared_ptr<PasteDataRecord> PasteData::PeekRecordAt(std::size_t index) const
+{
+    return LoadRecord(index);
+}
+
+std::shared_ptr<PasteDataRecord> PasteData::MutableRecordAt(std::size_t index)
+{
+    SetTypeIndex(nullptr);
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    auto record = LoadRecordLocked(index);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(record != nullptr, nullptr, PASTEBOARD_MODULE_COMMON,
+        "record is null, index=%{public}zu", index);
+    // One reference is held by records_ and one by the local copy above.
+    if (record.use_count() > 2) {
+        record = std::make_shared<PasteDataRecord>(*record);
+        records_[index] = record;
+    }
+    return record;
+}
+
+void PasteData::UnshareRecords()
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    LoadAllRecordsLocked();
+    for (auto &record : records_) {
+        if (record != nullptr && record.use_count() > 1) {
+            record = std::make_shared<PasteDataRecord>(*record);
+        }
+    }
+}
+
 std::shared_ptr<PasteDataRecord> PasteData::GetRecordById(uint32_t recordId) const
 { // LCOV_EXCL_START
-    for (const auto &record : records_) {
+    DropTypeIndex();
+    return PeekRecordById(recordId);
+} // LCOV_EXCL_STOP
+
+std::shared_ptr<PasteDataRecord> PasteData::PeekRecordById(uint32_t recordId) const
+{
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto record = LoadRecord(i);
         if (record != nullptr && record->GetRecordId() == recordId) {
             return record;
         }
     }
     return nullptr;
-} // LCOV_EXCL_STOP
+}
 
 std::size_t PasteData::GetRecordCount() const
 { // LCOV_EXCL_START
+    std::lock_guard<std::mutex> lock(lazyMutex_);
     return records_.size();
 } // LCOV_EXCL_STOP
 
@@ -389,8 +516,10 @@ void PasteData::SetTokenId(uint32_t tokenId)
 
 bool PasteData::RemoveRecordAt(std::size_t number)
 { // LCOV_EXCL_START
+    LoadAllRecords();
     if (records_.size() > number) {
         records_.erase(records_.begin() + static_cast<std::int64_t>(number));
+        SetTypeIndex(nullptr);
         RefreshMimeProp();
         return true;
     } else {
@@ -400,11 +529,13 @@ bool PasteData::RemoveRecordAt(std::size_t number)
 
 void PasteData::RemoveEmptyEntry()
 { // LCOV_EXCL_START
+    LoadAllRecords();
     for (auto &record : records_) {
         if (record != nullptr) {
             record->RemoveEmptyEntry();
         }
     }
+    SetTypeIndex(nullptr);
     RefreshMimeProp();
 } // LCOV_EXCL_STOP
 
@@ -413,8 +544,10 @@ bool PasteData::ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRec
     if (record == nullptr) {
         return false;
     }
+    LoadAllRecords();
     if (records_.size() > number) {
         records_[number] = std::move(record);
+        SetTypeIndex(nullptr);
         RefreshMimeProp();
         return true;
     } else {
@@ -424,7 +557,15 @@ bool PasteData::ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRec
 
 bool PasteData::HasMimeType(const std::string &mimeType)
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    auto typeIndex = GetTypeIndex();
+    if (typeIndex != nullptr) {
+        return PasteDataTypeIndex::Contains(typeIndex->allMimeTypes, mimeType);
+    }
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto item = LoadRecord(i);
+        if (item == nullptr) {
+            continue;
+        }
         auto itemTypes = item->GetMimeTypes();
         if (itemTypes.find(mimeType) != itemTypes.end()) {
             return true;
@@ -435,7 +576,15 @@ bool PasteData::HasMimeType(const std::string &mimeType)
 
 bool PasteData::HasUtdType(const std::string &utdType)
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    auto typeIndex = GetTypeIndex();
+    if (typeIndex != nullptr) {
+        return PasteDataTypeIndex::Contains(typeIndex->utdTypes, utdType);
+    }
+    for (size_t i = 0; i < GetRecordCount(); ++i) {
+        auto item = LoadRecord(i);
+        if (item == nullptr) {
+            continue;
+        }
         auto itemTypes = item->GetUtdTypes();
         if (itemTypes.find(utdType) != itemTypes.end()) {
             return true;
@@ -444,11 +593,72 @@ bool PasteData::HasUtdType(const std::string &utdType)
     return false;
 } // LCOV_EXCL_STOP
 
+bool PasteData::HasListedMimeType(const std::string &mimeType)
+{
+    auto typeIndex = GetTypeIndex();
+    if (typeIndex != nullptr) {
+        return PasteDataTypeIndex::Contains(typeIndex->mimeTypes, mimeType);
+    }
+    auto mimeTypes = GetMimeTypes();
+    return std::find(mimeTypes.begin(), mimeTypes.end(), mimeType) != mimeTypes.end();
+}
+
+void PasteData::BuildTypeIndex()
+{
+    LoadAllRecords();
+    std::set<std::string> mimeTypes;
+    std::set<std::string> allMimeTypes;
+    std::set<std::string> utdTypes;
+    for (const auto &item : records_) {
+        if (item == nullptr) {
+            continue;
+        }
+        auto itemMimeTypes = item->GetMimeTypes();
+        allMimeTypes.insert(itemMimeTypes.begin(), itemMimeTypes.end());
+        if (item->GetFrom() == 0 || item->GetRecordId() == item->GetFrom()) {
+            mimeTypes.insert(itemMimeTypes.begin(), itemMimeTypes.end());
+        }
+        auto itemUtdTypes = item->GetUtdTypes();
+        utdTypes.insert(itemUtdTypes.begin(), itemUtdTypes.end());
+    }
+    auto typeIndex = std::make_shared<PasteDataTypeIndex>();
+    typeIndex->mimeTypes.assign(mimeTypes.begin(), mimeTypes.end());
+    typeIndex->allMimeTypes.assign(allMimeTypes.begin(), allMimeTypes.end());
+    typeIndex->utdTypes.assign(utdTypes.begin(), utdTypes.end());
+    SetTypeIndex(std::move(typeIndex));
+}
+
+std::shared_ptr<const PasteDataTypeIndex> PasteData::GetTypeIndex() const
+{
+    std::lock_guard<std::mutex> lock(typeIndexMutex_);
+    return typeIndex_;
+}
+
+void PasteData::SetTypeIndex(std::shared_ptr<const PasteDataTypeIndex> typeIndex)
+{
+    std::lock_guard<std::mutex> lock(typeIndexMutex_);
+    typeIndex_ = std::move(typeIndex);
+}
+
+void PasteData::DropTypeIndex() const
+{
+    std::lock_guard<std::mutex> lock(typeIndexMutex_);
+    typeIndex_ = nullptr;
+}
+
 std::vector<std::shared_ptr<PasteDataRecord>> PasteData::AllRecords() const
 { // LCOV_EXCL_START
-    return this->records_;
+    DropTypeIndex();
+    return PeekRecords();
 } // LCOV_EXCL_STOP
 
+std::vector<std::shared_ptr<PasteDataRecord>> PasteData::PeekRecords() const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    LoadAllRecordsLocked();
+    return records_;
+}
+
 bool PasteData::IsDraggedData() const
 { // LCOV_EXCL_START
     return isDraggedData_;
@@ -578,6 +788,7 @@ bool PasteData::GetLocalOnly()
 
 void PasteData::RefreshMimeProp()
 { // LCOV_EXCL_START
+    LoadAllRecords();
     std::vector<std::string> mimeTypes;
     for (const auto &record : records_) {
         if (record == nullptr) {
@@ -591,8 +802,14 @@ void PasteData::RefreshMimeProp()
 bool PasteData::EncodeTLV(WriteOnlyBuffer &buffer) const
 {
     bool ret = buffer.Write(TAG_PROPS, props_);
-    ret = ret && buffer.Write(TAG_RECORDS, records_);
-    ret = ret && buffer.Write(TAG_DRAGGED_DATA_FLAG, isDraggedData_);
+    ret = ret && EncodeRecordsTLV(buffer);
+    ret = ret && EncodeAttributesTLV(buffer);
+    return ret;
+}
+
+bool PasteData::EncodeAttributesTLV(WriteOnlyBuffer &buffer) const
+{
+    bool ret = buffer.Write(TAG_DRAGGED_DATA_FLAG, isDraggedData_);
     ret = ret && buffer.Write(TAG_LOCAL_PASTE_FLAG, isLocalPaste_);
     ret = ret && buffer.Write(TAG_DELAY_DATA_FLAG, isDelayData_);
     ret = ret && buffer.Write(TAG_DEVICE_ID, deviceId_);
@@ -601,11 +818,103 @@ bool PasteData::EncodeTLV(WriteOnlyBuffer &buffer) const
     ret = ret && buffer.Write(TAG_DATA_ID, dataId_);
     ret = ret && buffer.Write(TAG_RECORD_ID, recordId_);
     ret = ret && buffer.Write(TAG_USER_ID, userId_);
+    auto typeIndex = GetTypeIndex();
+    if (typeIndex != nullptr) {
+        ret = ret && buffer.Write(TAG_TYPE_INDEX, *typeIndex);
+    }
     return ret;
 }
 
+bool PasteData::EncodeRecordsTLV(WriteOnlyBuffer &buffer) const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    if (!lazyVisitors_.empty()) {
+        LoadAllRecordsLocked();
+    }
+    if (lazyBuffer_ == nullptr) {
+        return buffer.Write(TAG_RECORDS, records_);
+    }
+    // Records that were never loaded are copied back verbatim.
+    TLVSection section(
+        [this](WriteOnlyBuffer &buff) {
+            bool ret = true;
+            for (size_t i = 0; ret && i < records_.size(); ++i) {
+                if (lazyRecords_[i].loaded) {
+                    ret = buff.Write(TAG_VECTOR_ITEM, records_[i]);
+                    continue;
+                }
+                RawMem rawMem;
+                rawMem.buffer = reinterpret_cast<uintptr_t>(lazyBuffer_.get() + lazyRecords_[i].offset);
+                rawMem.bufferLen = lazyRecords_[i].length;
+                ret = buff.Write(TAG_VECTOR_ITEM, rawMem);
+            }
+            return ret;
+        },
+        [this]() { return CountRecordItems(); });
+    return buffer.Write(TAG_RECORDS, section);
+}
+
 bool PasteData::DecodeTLV(ReadOnlyBuffer &buffer)
 {
+    return DecodeFieldsTLV(buffer, false);
+}
+
+bool PasteData::DecodeLazily(const uint8_t *data, size_t size)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr && size > 0, false, PASTEBOARD_MODULE_COMMON,
+        "invalid data, size=%{public}zu", size);
+    auto copy = std::make_shared<const std::vector<uint8_t>>(data, data + size);
+    return DecodeLazily(std::shared_ptr<const uint8_t>(copy, copy->data()), size);
+}
+
+bool PasteData::DecodeLazily(std::shared_ptr<const uint8_t> data, size_t size)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr && size > 0, false, PASTEBOARD_MODULE_COMMON,
+        "invalid data, size=%{public}zu", size);
+    LoadAllRecords();
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    lazyBuffer_ = std::move(data);
+    lazyRecords_.assign(records_.size(), LazyRecord{});
+    ReadOnlyBuffer buffer(lazyBuffer_.get(), size);
+    bool ret = DecodeFieldsTLV(buffer, true);
+    bool hasPending = std::any_of(lazyRecords_.begin(), lazyRecords_.end(), [](const LazyRecord &lazyRecord) {
+        return !lazyRecord.loaded;
+    });
+    if (!ret) {
+        // Pending slots must not outlive the buffer they point into.
+        records_.erase(std::remove(records_.begin(), records_.end(), nullptr), records_.end());
+    }
+    if (!ret || !hasPending) {
+        lazyRecords_.clear();
+        lazyBuffer_ = nullptr;
+    }
+    return ret;
+}
+
+bool PasteData::IndexRecordsTLV(ReadOnlyBuffer &buffer, const TLVHead &head)
+{
+    std::vector<std::pair<size_t, uint32_t>> spans;
+    if (!buffer.ReadItemSpans(spans, head)) {
+        return false;
+    }
+    for (const auto &[offset, length] : spans) {
+        // Field framing is checked now so a corrupt clip fails here, like the eager decode does.
+        ReadOnlyBuffer recordBuffer(lazyBuffer_.get() + offset, length);
+        while (recordBuffer.IsEnough()) {
+            TLVHead fieldHead{};
+            bool ret = recordBuffer.ReadHead(fieldHead) && recordBuffer.Skip(fieldHead.len);
+            PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON,
+                "invalid record field, index=%{public}zu, tag=%{public}hu", records_.size(), fieldHead.tag);
+        }
+        records_.emplace_back(nullptr);
+        lazyRecords_.push_back({ offset, length, false });
+    }
+    return true;
+}
+
+bool PasteData::DecodeFieldsTLV(ReadOnlyBuffer &buffer, bool lazy)
+{
+    SetTypeIndex(nullptr);
     for (; buffer.IsEnough();) {
         TLVHead head{};
         bool ret = buffer.ReadHead(head);
@@ -613,7 +922,7 @@ bool PasteData::DecodeTLV(ReadOnlyBuffer &buffer)
         if (head.tag == TAG_PROPS) {
             ret = buffer.ReadValue(props_, head);
         } else if (head.tag == TAG_RECORDS) {
-            ret = buffer.ReadValue(records_, head);
+            ret = lazy ? IndexRecordsTLV(buffer, head) : buffer.ReadValue(records_, head);
         } else if (head.tag == TAG_DRAGGED_DATA_FLAG) {
             ret = buffer.ReadValue(isDraggedData_, head);
         } else if (head.tag == TAG_LOCAL_PASTE_FLAG) {
@@ -632,6 +941,10 @@ bool PasteData::DecodeTLV(ReadOnlyBuffer &buffer)
             ret = buffer.ReadValue(recordId_, head);
         } else if (head.tag == TAG_USER_ID) {
             ret = buffer.ReadValue(userId_, head);
+        } else if (head.tag == TAG_TYPE_INDEX) {
+            auto typeIndex = std::make_shared<PasteDataTypeIndex>();
+            ret = buffer.ReadValue(*typeIndex, head);
+            SetTypeIndex(ret ? std::move(typeIndex) : nullptr);
         } else {
             ret = buffer.Skip(head.len);
         }
@@ -645,7 +958,99 @@ size_t PasteData::CountTLV() const
 {
     size_t expectSize = 0;
     expectSize += TLVCountable::Count(props_);
-    expectSize += TLVCountable::Count(records_);
+    expectSize += CountRecordsTLV();
+    expectSize += CountAttributesTLV();
+    return expectSize;
+}
+
+size_t PasteData::CountRecordsTLV() const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    if (!lazyVisitors_.empty()) {
+        LoadAllRecordsLocked();
+    }
+    return sizeof(TLVHead) + CountRecordItems();
+}
+
+size_t PasteData::CountRecordItems() const
+{
+    size_t expectSize = 0;
+    for (size_t i = 0; i < records_.size(); ++i) {
+        if (lazyBuffer_ != nullptr && !lazyRecords_[i].loaded) {
+            expectSize += sizeof(TLVHead) + lazyRecords_[i].length;
+        } else {
+            expectSize += TLVCountable::Count(records_[i]);
+        }
+    }
+    return expectSize;
+}
+
+std::shared_ptr<PasteDataRecord> PasteData::LoadRecord(size_t index) const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    return LoadRecordLocked(index);
+}
+
+std::shared_ptr<PasteDataRecord> PasteData::LoadRecordLocked(size_t index) const
+{
+    if (index >= records_.size()) {
+        return nullptr;
+    }
+    if (lazyBuffer_ == nullptr || lazyRecords_[index].loaded) {
+        return records_[index];
+    }
+    auto &lazyRecord = lazyRecords_[index];
+    lazyRecord.loaded = true;
+    ReadOnlyBuffer buffer(lazyBuffer_.get() + lazyRecord.offset, lazyRecord.length);
+    auto record = std::make_shared<PasteDataRecord>();
+    if (!record->DecodeTLV(buffer)) {
+        // An empty record keeps the slot, so indexes and the record count stay what the sender wrote.
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "decode record failed, index=%{public}zu", index);
+        record = std::make_shared<PasteDataRecord>();
+    }
+    for (const auto &visitor : lazyVisitors_) {
+        visitor(*record);
+    }
+    records_[index] = record;
+    return record;
+}
+
+void PasteData::LoadAllRecords() const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    LoadAllRecordsLocked();
+}
+
+void PasteData::LoadAllRecordsLocked() const
+{
+    if (lazyBuffer_ == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < records_.size(); ++i) {
+        LoadRecordLocked(i);
+    }
+    lazyRecords_.clear();
+    lazyBuffer_ = nullptr;
+    lazyVisitors_.clear();
+}
+
+void PasteData::VisitRecords(const std::function<void(PasteDataRecord &)> &visitor)
+{
+    SetTypeIndex(nullptr);
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    for (const auto &record : records_) {
+        if (record != nullptr) {
+            visitor(*record);
+        }
+    }
+    if (lazyBuffer_ != nullptr) {
+        lazyVisitors_.push_back(visitor);
+    }
+}
+
+size_t PasteData::CountAttributesTLV() const
+{
+    size_t expectSize = 0;
     expectSize += TLVCountable::Count(isDraggedData_);
     expectSize += TLVCountable::Count(isLocalPaste_);
     expectSize += TLVCountable::Count(isDelayData_);
@@ -655,9 +1060,28 @@ size_t PasteData::CountTLV() const
     expectSize += TLVCountable::Count(dataId_);
     expectSize += TLVCountable::Count(recordId_);
     expectSize += TLVCountable::Count(userId_);
+    auto typeIndex = GetTypeIndex();
+    if (typeIndex != nullptr) {
+        expectSize += TLVCountable::Count(*typeIndex);
+    }
     return expectSize;
 }
 
+bool PasteData::EncodeRecords(std::vector<uint8_t> &buffer) const
+{
+    TLVSection section([this](WriteOnlyBuffer &buff) { return EncodeRecordsTLV(buff); },
+        [this]() { return CountRecordsTLV(); });
+    return section.Encode(buffer);
+}
+
+bool PasteData::EncodeWithoutRecords(std::vector<uint8_t> &buffer) const
+{
+    TLVSection section(
+        [this](WriteOnlyBuffer &buff) { return buff.Write(TAG_PROPS, props_) && EncodeAttributesTLV(buff); },
+        [this]() { return TLVCountable::Count(props_) + CountAttributesTLV(); });
+    return section.Encode(buffer);
+}
+
 bool PasteData::IsValid() const
 { // LCOV_EXCL_START
     return valid_;
@@ -840,6 +1264,63 @@ size_t PasteDataProperty::CountTLV() const
     return expectedSize;
 }
 
+bool PasteDataTypeIndex::Contains(const std::vector<std::string> &types, const std::string &type)
+{
+    return std::binary_search(types.begin(), types.end(), type);
+}
+
+bool PasteDataTypeIndex::EncodeTLV(WriteOnlyBuffer &buffer) const
+{
+    bool ret = buffer.Write(TAG_INDEX_MIME_TYPES, mimeTypes);
+    ret = ret && buffer.Write(TAG_INDEX_ALL_MIME_TYPES, allMimeTypes);
+    ret = ret && buffer.Write(TAG_INDEX_UTD_TYPES, utdTypes);
+    if (!recordSizes.empty()) {
+        ret = ret && buffer.Write(TAG_INDEX_RECORD_SIZES, recordSizes);
+    }
+    return ret;
+}
+
+bool PasteDataTypeIndex::DecodeTLV(ReadOnlyBuffer &buffer)
+{
+    for (; buffer.IsEnough();) {
+        TLVHead head{};
+        bool ret = buffer.ReadHead(head);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON, "read head failed");
+        if (head.tag == TAG_INDEX_MIME_TYPES) {
+            ret = buffer.ReadValue(mimeTypes, head);
+        } else if (head.tag == TAG_INDEX_ALL_MIME_TYPES) {
+            ret = buffer.ReadValue(allMimeTypes, head);
+        } else if (head.tag == TAG_INDEX_UTD_TYPES) {
+            ret = buffer.ReadValue(utdTypes, head);
+        } else if (head.tag == TAG_INDEX_RECORD_SIZES) {
+            ret = buffer.ReadValue(recordSizes, head);
+        } else {
+            ret = buffer.Skip(head.len);
+        }
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON,
+            "read value failed, tag=%{public}hu, len=%{public}u", head.tag, head.len);
+    }
+    // Contains relies on the order, do not trust the sender for it
+    for (auto *types : { &mimeTypes, &allMimeTypes, &utdTypes }) {
+        if (!std::is_sorted(types->begin(), types->end())) {
+            std::sort(types->begin(), types->end());
+        }
+    }
+    return true;
+}
+
+size_t PasteDataTypeIndex::CountTLV() const
+{
+    size_t expectedSize = 0;
+    expectedSize += TLVCountable::Count(mimeTypes);
+    expectedSize += TLVCountable::Count(allMimeTypes);
+    expectedSize += TLVCountable::Count(utdTypes);
+    if (!recordSizes.empty()) {
+        expectedSize += TLVCountable::Count(recordSizes);
+    }
+    return expectedSize;
+}
+
 void PasteData::ShareOptionToString(ShareOption shareOption, std::string &out)
 { // LCOV_EXCL_START
     if (shareOption == ShareOption::InApp) {
@@ -490,34 +490,39 @@ int32_t PasteboardClient::ProcessPasteData(T &data, int64_t rawDataSize, int fd,
         return ret;
     }
     fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
-    MessageParcelWarp messageReply;
-    if (rawDataSize <= 0 || rawDataSize > messageReply.GetRawDataSize()) {
+    if (rawDataSize <= 0 || rawDataSize > MessageParcelWarp::GetRawDataSize()) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Invalid raw data size:%{public}" PRId64, rawDataSize);
         CloseSharedMemFd(fd);
         return static_cast<int32_t>(PasteboardError::INVALID_DATA_SIZE);
     }
     bool result = false;
-    MessageParcel parcelData;
     if (rawDataSize > MIN_ASHMEM_DATA_SIZE) {
-        parcelData.WriteInt64(rawDataSize);
-        parcelData.WriteFileDescriptor(fd);
+        // The mapping belongs to the warp, data keeps both alive so pending records are never copied.
+        struct RawDataHolder {
+            MessageParcel parcel;
+            MessageParcelWarp warp;
+        };
+        auto holder = std::make_shared<RawDataHolder>();
+        holder->parcel.WriteInt64(rawDataSize);
+        holder->parcel.WriteFileDescriptor(fd);
         CloseSharedMemFd(fd);
-        const uint8_t *rawData =
-            reinterpret_cast<const uint8_t *>(messageReply.ReadRawData(parcelData, static_cast<size_t>(rawDataSize)));
+        const uint8_t *rawData = reinterpret_cast<const uint8_t *>(
+            holder->warp.ReadRawData(holder->parcel, static_cast<size_t>(rawDataSize)));
         if (rawData == nullptr) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "mmap failed, size=%{public}" PRId64, rawDataSize);
             return ret;
         }
-        std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-        result = data.Decode(pasteDataTlv);
+        result = data.DecodeLazily(std::shared_ptr<const uint8_t>(holder, rawData),
+            static_cast<size_t>(rawDataSize));
     } else {
-        result = data.Decode(recvTLV);
+        result = data.DecodeLazily(recvTLV.data(), recvTLV.size());
         CloseSharedMemFd(fd);
     }
     if (!result) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to decode pastedata in TLV");
         return ret;
     }
+    data.rawDataSize_ = rawDataSize;
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
 
@@ -731,31 +736,35 @@ void PasteboardClient::CreateGetterAgent(sptr<PasteboardDelayGetterClient> &dela
 int32_t PasteboardClient::WritePasteData(PasteData &pasteData, std::vector<uint8_t> &buffer, int &fd,
     int64_t &tlvSize, MessageParcelWarp &messageData, MessageParcel &parcelPata)
 {
+    TLVSizingContext sizingContext;
     tlvSize = static_cast<int64_t>(pasteData.Count());
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < tlvSize && tlvSize <= MessageParcelWarp::GetRawDataSize(),
         static_cast<int32_t>(PasteboardError::INVALID_DATA_SIZE), PASTEBOARD_MODULE_CLIENT,
         "invalid data size, dataSize=%{public}" PRId64, tlvSize);
-    std::vector<uint8_t> pasteDataTlv(0);
-    bool result = pasteData.Encode(tlvSize, pasteDataTlv);
-    if (!result) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "paste data encode failed.");
-        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
-    }
     if (tlvSize > MIN_ASHMEM_DATA_SIZE) {
-        if (!messageData.WriteRawData(parcelPata, pasteDataTlv.data(), pasteDataTlv.size())) {
+        // encode straight into the shared memory instead of staging the TLV on the heap
+        bool result = messageData.WriteRawData(parcelPata, static_cast<size_t>(tlvSize),
+            [&pasteData](void *data, size_t size) { return pasteData.Encode(static_cast<uint8_t *>(data), size); });
+        if (!result) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to WriteRawData");
             return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
         }
         fd = messageData.GetWriteDataFd();
-        pasteDataTlv.clear();
+        buffer.clear();
     } else {
+        std::vector<uint8_t> pasteDataTlv(0);
+        bool result = pasteData.Encode(tlvSize, pasteDataTlv);
+        if (!result) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "paste data encode failed.");
+            return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+        }
         fd = messageData.CreateTmpFd();
         if (fd < 0) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to create tmp fd");
             return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
         }
+        buffer = std::move(pasteDataTlv);
     }
-    buffer = std::move(pasteDataTlv);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "set: fd:%{public}d, size:%{public}" PRId64, fd, tlvSize);
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
@@ -1267,7 +1276,8 @@ std::string PasteboardClient::GetPasteDataInfoSummary(const PasteData &pasteData
     // Deal with pasteData info
     json RadarReportInfoInJson = {
         {"PasteBundle", pasteData.GetBundleName().empty() ? "/" : pasteData.GetBundleName()},
-        {"PasteDataSize", pasteData.CountTLV()},
+        {"PasteDataSize", pasteData.rawDataSize_ > 0 ? static_cast<size_t>(pasteData.rawDataSize_) :
+            pasteData.CountTLV()},
         {"RecordCount", pasteData.GetRecordCount()},
         {"IsRemote", pasteData.IsRemote()},
         {"IsDelayData", pasteData.IsDelayData()},
@@ -16,11 +16,16 @@
 #include "pasteboard_img_extractor.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cerrno>
+#include <condition_variable>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
+#include "ffrt/ffrt_utils.h"
 #include "ipc_skeleton.h"
 #include "pasteboard_common.h"
 #include "pasteboard_hilog.h"
@@ -29,97 +34,300 @@
 namespace OHOS {
 namespace MiscServices {
 constexpr uid_t HWF_SERVICE_UID = 7700;
+constexpr size_t PARALLEL_RESOLVE_THRESHOLD = 8;
+constexpr size_t MAX_RESOLVE_HELPERS = 3;
+constexpr const char *IMG_TAG_NAME = "img";
+constexpr const char *SRC_ATTR_NAME = "src";
+constexpr const char *COMMENT_HEAD = "<!--";
+constexpr const char *COMMENT_TAIL = "-->";
+constexpr const char *HTML_SPACES = " \t\n\f\r";
+constexpr const char *TAG_NAME_ENDS = " \t\n\f\r/>";
+constexpr const char *ATTR_NAME_ENDS = " \t\n\f\r/>=";
+constexpr const char *ATTR_VALUE_ENDS = " \t\n\f\r>";
+// elements whose content is text up to the close tag, raw text (script, style) and RCDATA (textarea, title)
+constexpr const char *RAW_TEXT_TAGS[] = { "script", "style", "textarea", "title" };
 
-PasteboardImgExtractor &PasteboardImgExtractor::GetInstance()
+static bool EqualsIgnoreCase(const std::string &str, size_t pos, const char *lowerWord)
 {
-    static PasteboardImgExtractor instance;
-    return instance;
+    size_t len = std::strlen(lowerWord);
+    if (pos + len > str.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        if (std::tolower(static_cast<unsigned char>(str[pos + i])) != lowerWord[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
-PasteboardImgExtractor::PasteboardImgExtractor()
+static bool IsTagNameEnd(const std::string &str, size_t pos)
 {
-    std::lock_guard lock(mutex_);
-    xmlInitParser();
+    return pos >= str.size() || str[pos] == '>' || str[pos] == '/' ||
+        std::isspace(static_cast<unsigned char>(str[pos])) != 0;
 }
 
-PasteboardImgExtractor::~PasteboardImgExtractor()
+PasteboardImgExtractor &PasteboardImgExtractor::GetInstance()
 {
-    std::lock_guard lock(mutex_);
-    xmlCleanupParser();
+    static PasteboardImgExtractor instance;
+    return instance;
 }
 
 std::vector<std::string> PasteboardImgExtractor::ExtractImgSrc(const std::string &htmlContent,
     const std::string &bundleIndex, int32_t userId)
 {
-    std::lock_guard lock(mutex_);
-    int options = HTML_PARSE_RECOVER | HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING;
-    xmlDocPtr doc = htmlReadDoc(reinterpret_cast<const xmlChar *>(htmlContent.c_str()), nullptr, nullptr, options);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(doc != nullptr, {}, PASTEBOARD_MODULE_COMMON, "parse html failed");
+    std::vector<std::string> uris;
+    for (const auto &tag : ScanImgTags(htmlContent)) {
+        for (const auto &src : tag.srcs) {
+            uris.push_back(src.first);
+        }
+    }
+    return FilterValidImgSrc(std::move(uris), bundleIndex, userId);
+}
 
-    std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> docGuard(doc, xmlFreeDoc);
-    auto uris = FindImgsExcludingSpan(doc);
+std::vector<std::string> PasteboardImgExtractor::FilterValidImgSrc(std::vector<std::string> uris,
+    const std::string &bundleIndex, int32_t userId)
+{
     FilterFileUris(uris);
     FilterImgUris(uris);
     FilterExistFileUris(uris, bundleIndex, userId);
     return uris;
 }
 
-void PasteboardImgExtractor::FilterExistFileUris(std::vector<std::string> &uris, const std::string &bundleIndex,
-    int32_t userId)
+std::vector<PasteboardImgExtractor::ImgTag> PasteboardImgExtractor::ScanImgTags(const std::string &html)
 {
-    std::vector<std::string> existFileUris;
-    std::string userIdStr = std::to_string(userId);
-    auto callingUid = IPCSkeleton::GetCallingUid();
-    for (const std::string &uriStr : uris) {
-        if (!AppFileService::SandboxHelper::IsValidPath(uriStr)) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "uri path invalid, uri=%{private}s", uriStr.c_str());
+    std::vector<ImgTag> tags;
+    size_t nameLen = std::strlen(IMG_TAG_NAME);
+    size_t pos = 0;
+    while ((pos = html.find('<', pos)) != std::string::npos) {
+        if (html.compare(pos, std::strlen(COMMENT_HEAD), COMMENT_HEAD) == 0) {
+            size_t end = html.find(COMMENT_TAIL, pos + std::strlen(COMMENT_HEAD));
+            if (end == std::string::npos) {
+                break;
+            }
+            pos = end + std::strlen(COMMENT_TAIL);
             continue;
         }
-        std::string oldUriStr = uriStr;
-        std::string newUriStr;
-        if (oldUriStr.find(PasteboardImgExtractor::IMG_LOCAL_URI) != 0) {
+        size_t rawTextEnd = SkipRawText(html, pos);
+        if (rawTextEnd != pos) {
+            pos = rawTextEnd;
             continue;
-        } else if (oldUriStr.find(PasteboardImgExtractor::DOC_LOCAL_URI) == 0) {
-            newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::DOC_LOCAL_URI),
-                PasteboardImgExtractor::DOC_URI_PREFIX);
-        } else {
-            newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::IMG_LOCAL_URI),
-                PasteboardImgExtractor::FILE_SCHEME_PREFIX + bundleIndex + "/");
-        }
-
-        std::string physicalPath;
-        if (callingUid == HWF_SERVICE_UID && oldUriStr.find("file://docs/storage/Users/currentUser/") == 0) {
-            physicalPath = oldUriStr.replace(0, std::strlen("file://docs/storage/Users/currentUser/"), "/mnt/");
-        } else {
-            int32_t ret = AppFileService::SandboxHelper::GetPhysicalPath(newUriStr, userIdStr, physicalPath);
-            if (ret != 0) {
-                PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "get phy path fail, uri=%{private}s", newUriStr.c_str());
-                continue;
-            }
         }
+        bool isTag = pos + 1 < html.size() &&
+            (std::isalpha(static_cast<unsigned char>(html[pos + 1])) != 0 || html[pos + 1] == '/');
+        if (!isTag) {
+            ++pos;
+            continue;
+        }
+        // every tag is skipped as a whole, so an <img inside an attribute value is not taken for a tag
+        size_t end = FindTagEnd(html, pos + 1);
+        if (end == std::string::npos) {
+            break;
+        }
+        if (EqualsIgnoreCase(html, pos + 1, IMG_TAG_NAME) && IsTagNameEnd(html, pos + 1 + nameLen)) {
+            ImgTag tag;
+            tag.offset = static_cast<uint32_t>(pos);
+            tag.length = static_cast<uint32_t>(end + 1 - pos);
+            tag.srcs = ScanImgSrcs(html.substr(pos, tag.length), tag.offset);
+            tags.push_back(std::move(tag));
+        }
+        pos = end + 1;
+    }
+    return tags;
+}
 
-        errno = 0;
-        struct stat buf = {};
-        if (PasteBoardCommon::Stat(physicalPath, &buf) != 0) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "stat fail, uri=%{private}s, path=%{private}s, err=%{public}d",
-                newUriStr.c_str(), physicalPath.c_str(), errno);
-            if (errno == EACCES) {
-                existFileUris.push_back(uriStr);
-            }
+std::vector<std::pair<std::string, uint32_t>> PasteboardImgExtractor::ScanImgSrcs(const std::string &tag,
+    uint32_t tagOffset)
+{
+    std::vector<std::pair<std::string, uint32_t>> srcs;
+    // skip the tag name, then walk the attributes as name[=value] pairs
+    size_t pos = tag.find_first_of(TAG_NAME_ENDS, tag.empty() || tag[0] != '<' ? 0 : 1);
+    while (pos < tag.size() && tag[pos] != '>') {
+        if (tag[pos] == '/' || std::isspace(static_cast<unsigned char>(tag[pos])) != 0) {
+            ++pos;
+            continue;
+        }
+        size_t nameEnd = tag.find_first_of(ATTR_NAME_ENDS, pos + 1);
+        if (nameEnd == std::string::npos) {
+            break;
+        }
+        bool isSrc = nameEnd - pos == std::strlen(SRC_ATTR_NAME) && EqualsIgnoreCase(tag, pos, SRC_ATTR_NAME);
+        pos = tag.find_first_not_of(HTML_SPACES, nameEnd);
+        if (pos == std::string::npos || tag[pos] != '=') {
             continue;
         }
+        pos = tag.find_first_not_of(HTML_SPACES, pos + 1);
+        if (pos == std::string::npos) {
+            break;
+        }
+        if (tag[pos] != '"' && tag[pos] != '\'') {
+            pos = tag.find_first_of(ATTR_VALUE_ENDS, pos);
+            continue;
+        }
+        size_t close = tag.find(tag[pos], pos + 1);
+        if (close == std::string::npos) {
+            break;
+        }
+        if (isSrc) {
+            srcs.emplace_back(tag.substr(pos + 1, close - pos - 1), tagOffset + static_cast<uint32_t>(pos + 1));
+        }
+        pos = close + 1;
+    }
+    return srcs;
+}
 
-        if ((buf.st_mode & S_IFMT) == S_IFDIR) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "is dir, uri=%{private}s, path=%{private}s",
-                newUriStr.c_str(), physicalPath.c_str());
+size_t PasteboardImgExtractor::FindTagEnd(const std::string &html, size_t pos)
+{
+    while (pos < html.size()) {
+        if (html[pos] == '>') {
+            return pos;
+        }
+        if (html[pos] != '=') {
+            ++pos;
             continue;
         }
+        // a quoted value may hold '>', skip it to its closing quote
+        pos = html.find_first_not_of(HTML_SPACES, pos + 1);
+        if (pos == std::string::npos) {
+            break;
+        }
+        if (html[pos] == '"' || html[pos] == '\'') {
+            pos = html.find(html[pos], pos + 1);
+            if (pos == std::string::npos) {
+                break;
+            }
+            ++pos;
+        }
+    }
+    return std::string::npos;
+}
 
-        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_COMMON, "uri=%{private}s, path=%{private}s, size=%{public}zu",
-            newUriStr.c_str(), physicalPath.c_str(), static_cast<size_t>(buf.st_size));
-        existFileUris.push_back(uriStr);
+size_t PasteboardImgExtractor::SkipRawText(const std::string &html, size_t pos)
+{
+    for (const char *name : RAW_TEXT_TAGS) {
+        size_t nameLen = std::strlen(name);
+        if (!EqualsIgnoreCase(html, pos + 1, name) || !IsTagNameEnd(html, pos + 1 + nameLen)) {
+            continue;
+        }
+        size_t next = FindTagEnd(html, pos + 1 + nameLen);
+        if (next == std::string::npos) {
+            return html.size();
+        }
+        // the content runs to the matching close tag, or to the end of the html
+        for (size_t end = html.find("</", next); end != std::string::npos; end = html.find("</", end + 1)) {
+            if (EqualsIgnoreCase(html, end + std::strlen("</"), name) &&
+                IsTagNameEnd(html, end + std::strlen("</") + nameLen)) {
+                return end + std::strlen("</") + nameLen;
+            }
+        }
+        return html.size();
     }
-    uris = existFileUris;
+    return pos;
+}
+
+void PasteboardImgExtractor::FilterExistFileUris(std::vector<std::string> &uris, const std::string &bundleIndex,
+    int32_t userId)
+{
+    // pages often reference the same image many times, resolve each distinct uri once
+    std::vector<std::string> distinctUris;
+    std::unordered_map<std::string, size_t> uriIndexes;
+    for (const std::string &uriStr : uris) {
+        if (uriIndexes.emplace(uriStr, distinctUris.size()).second) {
+            distinctUris.push_back(uriStr);
+        }
+    }
+
+    // calling uid is thread local to the ipc thread, read it before fanning out
+    auto callingUid = IPCSkeleton::GetCallingUid();
+    std::string userIdStr = std::to_string(userId);
+    std::vector<uint8_t> exists(distinctUris.size(), 0);
+    struct ResolveState {
+        std::mutex mutex;
+        std::condition_variable cond;
+        size_t next = 0;
+        size_t done = 0;
+    };
+    auto state = std::make_shared<ResolveState>();
+    size_t total = distinctUris.size();
+    // A helper that starts after every index is claimed returns at once, so it never touches the vectors.
+    auto resolve = [state, total, &distinctUris, &exists, &bundleIndex, &userIdStr, callingUid]() {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (state->next < total) {
+            size_t i = state->next++;
+            lock.unlock();
+            exists[i] = IsExistFileUri(distinctUris[i], bundleIndex, userIdStr, callingUid) ? 1 : 0;
+            lock.lock();
+            if (++state->done == total) {
+                state->cond.notify_all();
+            }
+        }
+    };
+    size_t helperNum = total < PARALLEL_RESOLVE_THRESHOLD ? 0 : MAX_RESOLVE_HELPERS;
+    for (size_t i = 0; i < helperNum; ++i) {
+        FFRTUtils::SubmitBlockingTask(resolve);
+    }
+    // the caller resolves too, so the call completes even when every shared worker is busy
+    resolve();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cond.wait(lock, [&state, total] { return state->done == total; });
+
+    std::vector<std::string> existFileUris;
+    for (const std::string &uriStr : uris) {
+        if (exists[uriIndexes[uriStr]] != 0) {
+            existFileUris.push_back(uriStr);
+        }
+    }
+    uris = std::move(existFileUris);
+}
+
+bool PasteboardImgExtractor::IsExistFileUri(const std::string &uriStr, const std::string &bundleIndex,
+    const std::string &userIdStr, uid_t callingUid)
+{
+    if (!AppFileService::SandboxHelper::IsValidPath(uriStr)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "uri path invalid, uri=%{private}s", uriStr.c_str());
+        return false;
+    }
+    std::string oldUriStr = uriStr;
+    std::string newUriStr;
+    if (oldUriStr.find(PasteboardImgExtractor::IMG_LOCAL_URI) != 0) {
+        return false;
+    } else if (oldUriStr.find(PasteboardImgExtractor::DOC_LOCAL_URI) == 0) {
+        newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::DOC_LOCAL_URI),
+            PasteboardImgExtractor::DOC_URI_PREFIX);
+    } else {
+        newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::IMG_LOCAL_URI),
+            PasteboardImgExtractor::FILE_SCHEME_PREFIX + bundleIndex + "/");
+    }
+
+    std::string physicalPath;
+    if (callingUid == HWF_SERVICE_UID && oldUriStr.find("file://docs/storage/Users/currentUser/") == 0) {
+        physicalPath = oldUriStr.replace(0, std::strlen("file://docs/storage/Users/currentUser/"), "/mnt/");
+    } else {
+        int32_t ret = AppFileService::SandboxHelper::GetPhysicalPath(newUriStr, userIdStr, physicalPath);
+        if (ret != 0) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "get phy path fail, uri=%{private}s", newUriStr.c_str());
+            return false;
+        }
+    }
+
+    errno = 0;
+    struct stat buf = {};
+    if (PasteBoardCommon::Stat(physicalPath, &buf) != 0) {
+        int err = errno;
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "stat fail, uri=%{private}s, path=%{private}s, err=%{public}d",
+            newUriStr.c_str(), physicalPath.c_str(), err);
+        return err == EACCES;
+    }
+
+    if ((buf.st_mode & S_IFMT) == S_IFDIR) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "is dir, uri=%{private}s, path=%{private}s",
+            newUriStr.c_str(), physicalPath.c_str());
+        return false;
+    }
+
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_COMMON, "uri=%{private}s, path=%{private}s, size=%{public}zu",
+        newUriStr.c_str(), physicalPath.c_str(), static_cast<size_t>(buf.st_size));
+    return true;
 }
 
 void PasteboardImgExtractor::FilterFileUris(std::vector<std::string> &uris)
@@ -193,56 +401,5 @@ bool PasteboardImgExtractor::MatchImgExtension(const std::string &uri)
     std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
     return IMG_EXTENSIONS.find(extension) != IMG_EXTENSIONS.end();
 }
-
-std::vector<std::string> PasteboardImgExtractor::FindImgsExcludingSpan(xmlDocPtr doc)
-{
-    return ExecuteXPath(doc, "//img[@src]");
-}
-
-std::vector<std::string> PasteboardImgExtractor::ExecuteXPath(xmlDocPtr doc, const char *xpathExpr)
-{
-    xmlXPathContextPtr context = xmlXPathNewContext(doc);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(context != nullptr, {}, PASTEBOARD_MODULE_COMMON, "xpath new context failed");
-
-    std::unique_ptr<xmlXPathContext, decltype(&xmlXPathFreeContext)> contextGuard(context, xmlXPathFreeContext);
-    xmlXPathObjectPtr result = xmlXPathEvalExpression(reinterpret_cast<const xmlChar *>(xpathExpr), context);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(result != nullptr, {}, PASTEBOARD_MODULE_COMMON, "xpath eval expr failed");
-
-    std::unique_ptr<xmlXPathObject, decltype(&xmlXPathFreeObject)> resultGuard(result, xmlXPathFreeObject);
-    if (!result->nodesetval) {
-        return {};
-    }
-
-    std::vector<std::string> results;
-    xmlNodeSetPtr nodeSet = result->nodesetval;
-    for (auto i = 0; i < nodeSet->nodeNr; ++i) {
-        xmlNodePtr node = nodeSet->nodeTab[i];
-        if (node == nullptr) {
-            continue;
-        }
-
-        xmlChar *src = xmlGetProp(node, reinterpret_cast<const xmlChar *>("src"));
-        if (src == nullptr) {
-            continue;
-        }
-
-        std::string srcStr = SafeXmlToString(src);
-        if (!srcStr.empty()) {
-            results.push_back(srcStr);
-        }
-        xmlFree(src);
-    }
-    return results;
-}
-
-std::string PasteboardImgExtractor::SafeXmlToString(const xmlChar *xmlStr)
-{
-    if (xmlStr == nullptr) {
-        return "";
-    }
-
-    std::string result(reinterpret_cast<const char *>(xmlStr));
-    return result;
-}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
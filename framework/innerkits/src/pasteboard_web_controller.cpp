@@ -15,8 +15,6 @@
 
 #include "pasteboard_web_controller.h"
 
-#include <regex>
-
 #include "file_uri.h"
 #include "ipc_skeleton.h"
 #include "parameters.h"
@@ -26,9 +24,6 @@
 #include "uri_permission_manager_client.h"
 
 namespace {
-constexpr const char *IMG_TAG_PATTERN = "<img.*?>";
-constexpr const char *IMG_TAG_SRC_PATTERN = "src=(['\"])(.*?)\\1";
-constexpr const char *IMG_TAG_SRC_HEAD = "src=\"";
 constexpr const char *IMG_LOCAL_PATH = "://";
 constexpr const char *FILE_SCHEME = "file";
 
@@ -294,28 +289,21 @@ void PasteboardWebController::RemoveInvalidUri(PasteData &data)
         return;
     }
 
-    uint32_t removeCount = 0;
+    // Records still pending a lazy decode are handled when loaded and are not part of the count logged here.
+    auto removeCount = std::make_shared<uint32_t>(0);
     auto emptyUri = std::make_shared<OHOS::Uri>("");
-    size_t recordCount = data.GetRecordCount();
-    for (size_t i = 0; i < recordCount; ++i) {
-        auto record = data.GetRecordAt(i);
-        if (record == nullptr) {
-            continue;
-        }
-        auto uriPtr = record->GetOriginUri();
-        if (uriPtr == nullptr) {
-            continue;
-        }
-        if (IsValidUri(uriPtr, record->HasGrantUriPermission())) {
-            continue;
+    data.VisitRecords([this, emptyUri, removeCount](PasteDataRecord &record) {
+        auto uriPtr = record.GetOriginUri();
+        if (uriPtr == nullptr || IsValidUri(uriPtr, record.HasGrantUriPermission())) {
+            return;
         }
-        record->SetUri(emptyUri);
-        record->SetConvertUri("");
-        removeCount++;
-    }
+        record.SetUri(emptyUri);
+        record.SetConvertUri("");
+        (*removeCount)++;
+    });
 
-    if (removeCount > 0) {
-        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_COMMON, "remove count=%{public}u", removeCount);
+    if (*removeCount > 0) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_COMMON, "remove count=%{public}u", *removeCount);
     }
 }
 
@@ -326,12 +314,7 @@ void PasteboardWebController::RetainUri(PasteData &pasteData)
         return;
     }
     // clear convert uri
-    for (size_t i = 0; i < pasteData.GetRecordCount(); ++i) {
-        auto record = pasteData.GetRecordAt(i);
-        if (record != nullptr) {
-            record->SetConvertUri("");
-        }
-    }
+    pasteData.VisitRecords([](PasteDataRecord &record) { record.SetConvertUri(""); });
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "end");
 }
 
@@ -385,7 +368,11 @@ RecordList PasteboardWebController::SplitHtml2Records(const std::shared_ptr<std:
     if (imgSrcMap.empty()) {
         return {};
     }
-    auto validImgSrcList = PasteboardImgExtractor::GetInstance().ExtractImgSrc(*html, bundleIndex, userId);
+    std::vector<std::string> imgSrcList;
+    for (const auto &item : imgSrcMap) {
+        imgSrcList.push_back(item.first);
+    }
+    auto validImgSrcList = PasteboardImgExtractor::FilterValidImgSrc(std::move(imgSrcList), bundleIndex, userId);
     RemoveInvalidImgSrc(validImgSrcList, imgSrcMap);
     if (imgSrcMap.empty()) {
         return {};
@@ -406,18 +393,9 @@ void PasteboardWebController::MergeExtraUris2Html(PasteData &data)
 std::vector<std::pair<std::string, uint32_t>> PasteboardWebController::SplitHtmlWithImgLabel(
     const std::shared_ptr<std::string> html) noexcept
 {
-    std::smatch results;
-    std::string pattern(IMG_TAG_PATTERN);
-    std::regex reg(pattern);
-    std::string::const_iterator iterStart = html->begin();
-    std::string::const_iterator iterEnd = html->end();
     std::vector<std::pair<std::string, uint32_t>> matchVec;
-
-    while (std::regex_search(iterStart, iterEnd, results, reg)) {
-        std::string tmp = results[0];
-        iterStart = results[0].second;
-        uint32_t offset = static_cast<uint32_t>(results[0].first - html->begin());
-        matchVec.emplace_back(tmp, offset);
+    for (const auto &tag : PasteboardImgExtractor::ScanImgTags(*html)) {
+        matchVec.emplace_back(html->substr(tag.offset, tag.length), tag.offset);
     }
     return matchVec;
 }
@@ -426,24 +404,13 @@ std::map<std::string, std::vector<uint8_t>> PasteboardWebController::SplitHtmlWi
     const std::vector<std::pair<std::string, uint32_t>> &matchVec) noexcept
 {
     std::map<std::string, std::vector<uint8_t>> res;
-    std::smatch match;
-    std::regex re(IMG_TAG_SRC_PATTERN);
     for (const auto &node : matchVec) {
-        std::string::const_iterator iterStart = node.first.begin();
-        std::string::const_iterator iterEnd = node.first.end();
-
-        while (std::regex_search(iterStart, iterEnd, match, re)) {
-            std::string tmp = match[0];
-            iterStart = match[0].second;
-            uint32_t offset = static_cast<uint32_t>(match[0].first - node.first.begin());
-            tmp = tmp.substr(strlen(IMG_TAG_SRC_HEAD));
-            tmp.pop_back();
-            if (!IsLocalURI(tmp)) {
+        for (auto &[src, offset] : PasteboardImgExtractor::ScanImgSrcs(node.first, node.second)) {
+            if (!IsLocalURI(src)) {
                 continue;
             }
-            offset += strlen(IMG_TAG_SRC_HEAD) + node.second;
             for (uint32_t i = 0; i < FOUR_BYTES; i++) {
-                res[tmp].emplace_back((offset >> (EIGHT_BIT * i)) & 0xff);
+                res[src].emplace_back((offset >> (EIGHT_BIT * i)) & 0xff);
             }
         }
     }
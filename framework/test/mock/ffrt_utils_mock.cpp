@@ -28,6 +28,11 @@ void FFRTUtils::SubmitQueueTasks(const std::vector<FFRTTask> &tasks, FFRTQueue &
     (void)queue;
 }
 
+void FFRTUtils::SubmitBlockingTask(const FFRTTask &task)
+{
+    (void)task;
+}
+
 FFRTHandle FFRTUtils::SubmitDelayTask(FFRTTask &task, uint32_t delayMs, FFRTQueue &queue)
 {
     (void)task;
@@ -93,12 +98,24 @@ void FFRTTimer::SetTimer(const std::string &timerId, FFRTTask &task, uint32_t de
     (void)delayMs;
 }
 
+void FFRTTimer::SetBlockingTimer(const std::string &timerId, const FFRTTask &task, uint32_t delayMs)
+{
+    (void)timerId;
+    (void)task;
+    (void)delayMs;
+}
+
 uint32_t FFRTTimer::GetTaskId(const std::string &timerId)
 {
     (void)timerId;
     return 0;
 }
 
+FFRTTimer::Stats FFRTTimer::GetStats()
+{
+    return {};
+}
+
 void FFRTTimer::CancelAllTimerInner()
 {
 }
@@ -796,4 +796,53 @@ HWTEST_F(PasteboardImgExtractorMockTest, ExtractImgSrcTest018, TestSize.Level0)
     ASSERT_EQ(1U, uris.size());
     ASSERT_EQ("file:///test.png", uris[0]);
 }
+
+/**
+ * @tc.name: ExtractImgSrcTest019
+ * @tc.desc: ExtractImgSrc should resolve each distinct uri once and keep the original order
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardImgExtractorMockTest, ExtractImgSrcTest019, TestSize.Level0)
+{
+    constexpr int32_t imgNum = 20;
+    constexpr int32_t distinctNum = 10;
+    std::string htmlContent = "<html><body>";
+    for (int32_t i = 0; i < imgNum; ++i) {
+        htmlContent += "<img src=\"file:///test" + std::to_string(i % distinctNum) + ".png\">";
+    }
+    htmlContent += "</body></html>";
+    std::string bundleIndex = "testBundle";
+    int32_t userId = 100;
+
+    NiceMock<OHOS::AppFileService::SandboxHelperMock> sandboxMock;
+    EXPECT_CALL(sandboxMock, IsValidPath)
+        .WillRepeatedly(Return(true));
+    EXPECT_CALL(sandboxMock, GetPhysicalPath)
+        .Times(distinctNum)
+        .WillRepeatedly([](const std::string &uri, const std::string &userId, std::string &physicalPath) {
+            physicalPath = "/mnt/" + uri.substr(uri.find_last_of('/') + 1);
+            return 0;
+        });
+
+    // test0.png is a directory, every other file exists
+    NiceMock<PasteBoardCommonMock> PasteBoardCommonMock;
+    EXPECT_CALL(PasteBoardCommonMock, Stat)
+        .WillRepeatedly([](const char *path, struct stat *buf) {
+            buf->st_mode = std::string(path) == "/mnt/test0.png" ? S_IFDIR : S_IFREG;
+            buf->st_size = 1024;
+            return 0;
+        });
+
+    auto uris = PasteboardImgExtractor::GetInstance().ExtractImgSrc(htmlContent, bundleIndex, userId);
+    ASSERT_EQ(static_cast<size_t>(imgNum - imgNum / distinctNum), uris.size());
+    size_t index = 0;
+    for (int32_t i = 0; i < imgNum; ++i) {
+        if (i % distinctNum == 0) {
+            continue;
+        }
+        ASSERT_EQ("file:///test" + std::to_string(i % distinctNum) + ".png", uris[index++]);
+    }
+}
 } // anonymous namespace
@@ -414,5 +414,35 @@ PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "UnSubscribeProfileEventTest002 star
 #endif
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "UnSubscribeProfileEventTest002 end");
 }
+/**
+ * @tc.name: GetDeviceVersionCacheTest001
+ * @tc.desc: a cached version is served without the profile query until the peer goes offline
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DevProfileMockTest, GetDeviceVersionCacheTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetDeviceVersionCacheTest001 start");
+    NiceMock<DistributedDeviceProfile::DeviceProfileClientMock> dpMock;
+    EXPECT_CALL(dpMock, GetCharacteristicProfile)
+        .WillRepeatedly(testing::Return(DistributedDeviceProfile::DP_INVALID_PARAMS));
+    constexpr uint32_t cachedVersion = 6;
+    std::string udid = "versionCacheUdid";
+    DevProfile::GetInstance().versionCache_.InsertOrAssign(udid, cachedVersion);
+    auto before = DevProfile::GetInstance().GetVersionCacheStats();
+    uint32_t versionId = 0;
+    EXPECT_TRUE(DevProfile::GetInstance().GetDeviceVersion(udid, versionId));
+    EXPECT_EQ(versionId, cachedVersion);
+    auto after = DevProfile::GetInstance().GetVersionCacheStats();
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_EQ(after.misses, before.misses);
+
+    DevProfile::GetInstance().EraseDeviceVersion(udid);
+    EXPECT_FALSE(DevProfile::GetInstance().GetDeviceVersion(udid, versionId));
+    EXPECT_EQ(DevProfile::GetInstance().GetVersionCacheStats().misses, before.misses + 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetDeviceVersionCacheTest001 end");
+}
+
 } // namespace MiscServices
 } // namespace OHOS
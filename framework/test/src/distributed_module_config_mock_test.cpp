@@ -391,5 +391,61 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion004, TestSize
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetRemoteDeviceMinVersion004 end");
 }
 
+/**
+ * @tc.name: GetRemoteDeviceVersionCache001
+ * @tc.desc: the version table is reused until a peer event invalidates it.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceVersionCache001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetRemoteDeviceVersionCache001 start");
+    DMAdapter::GetInstance().devices_.clear();
+    DistributedModuleConfig config;
+    EXPECT_EQ(config.GetRemoteDeviceMinVersion(), UINT_MAX);
+    EXPECT_EQ(config.GetRemoteDeviceMaxVersion(), 0);
+    auto stats = config.GetVersionStats();
+    EXPECT_EQ(stats.refreshes, 1);
+    EXPECT_EQ(stats.hits, 1);
+
+    config.InvalidateRemoteVersion();
+    EXPECT_EQ(config.GetRemoteDeviceMinVersion(), UINT_MAX);
+    stats = config.GetVersionStats();
+    EXPECT_EQ(stats.refreshes, 2);
+    EXPECT_EQ(stats.hits, 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetRemoteDeviceVersionCache001 end");
+}
+
+/**
+ * @tc.name: GetRemoteDeviceVersionCache002
+ * @tc.desc: the version table is not kept when the version of an enabled peer cannot be read.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceVersionCache002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetRemoteDeviceVersionCache002 start");
+    NiceMock<DistributedDeviceProfile::DeviceProfileClientMock> dpMock;
+    EXPECT_CALL(dpMock, GetCharacteristicProfile)
+        .WillRepeatedly([](auto, auto, auto, DistributedDeviceProfile::CharacteristicProfile &characteristicProfile) {
+            characteristicProfile.characteristicValue_ = "1";
+            return static_cast<int32_t>(DistributedDeviceProfile::DP_SUCCESS);
+        });
+    DMAdapter::GetInstance().devices_.clear();
+    DevProfile::GetInstance().enabledStatusCache_.Clear();
+    DevProfile::GetInstance().versionCache_.Clear();
+    DMAdapter::GetInstance().devices_.emplace("testUdid");
+    DistributedModuleConfig config;
+    EXPECT_EQ(config.GetRemoteDeviceMinVersion(), UINT_MAX);
+    EXPECT_EQ(config.GetRemoteDeviceMinVersion(), UINT_MAX);
+    auto stats = config.GetVersionStats();
+    EXPECT_EQ(stats.refreshes, 2);
+    EXPECT_EQ(stats.hits, 0);
+    DMAdapter::GetInstance().devices_.clear();
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetRemoteDeviceVersionCache002 end");
+}
+
 } // namespace MiscServices
 } // namespace OHOS
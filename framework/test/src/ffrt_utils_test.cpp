@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "ffrt/ffrt_utils.h"
 #include "pasteboard_hilog.h"
@@ -143,4 +145,53 @@ HWTEST_F(FFRTTimerTest, SubmitTimeoutTaskTest, TestSize.Level0)
     EXPECT_TRUE(res);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SubmitTimeoutTaskTest end");
 }
+
+/**
+ * @tc.name: SetBlockingTimerTest001
+ * @tc.desc: a blocking timer runs on the shared workers and is counted in the timer stats
+ * @tc.type: FUNC
+ */
+HWTEST_F(FFRTTimerTest, SetBlockingTimerTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SetBlockingTimerTest001 start");
+    FFRTTimer ffrtTimer("blocking_timer");
+    std::atomic<int32_t> fired = 0;
+    FFRTTask task = [&fired] {
+        fired++;
+    };
+    ffrtTimer.SetBlockingTimer("canceled", task, 1000);
+    ffrtTimer.SetBlockingTimer("fired", task, 5);
+    EXPECT_EQ(ffrtTimer.GetStats().pending, 2);
+    ffrtTimer.CancelTimer("canceled");
+    while (fired.load() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto stats = ffrtTimer.GetStats();
+    EXPECT_EQ(stats.pending, 0);
+    EXPECT_EQ(stats.fired, 1);
+    EXPECT_GE(stats.maxLatenessMs * stats.fired, stats.totalLatenessMs);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SetBlockingTimerTest001 end");
+}
+
+/**
+ * @tc.name: SubmitBlockingTaskTest001
+ * @tc.desc: blocking tasks run on the shared workers without blocking the submitter
+ * @tc.type: FUNC
+ */
+HWTEST_F(FFRTTimerTest, SubmitBlockingTaskTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SubmitBlockingTaskTest001 start");
+    constexpr int32_t taskNum = 8;
+    auto done = std::make_shared<std::atomic<int32_t>>(0);
+    for (int32_t i = 0; i < taskNum; ++i) {
+        FFRTUtils::SubmitBlockingTask([done] {
+            (*done)++;
+        });
+    }
+    while (done->load() < taskNum) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(done->load(), taskNum);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SubmitBlockingTaskTest001 end");
+}
 } // namespace OHOS::MiscServices
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "device/distributed_module_config.h"
+#include "global_event_codec.h"
+#include "pasteboard_hilog.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace OHOS::MiscServices;
+
+namespace {
+constexpr uint32_t OLD_PEER_VERSION = DistributedModuleConfig::Version::VERSION_SIX;
+constexpr uint32_t NEW_PEER_VERSION = DistributedModuleConfig::Version::VERSION_SEVEN;
+constexpr size_t CODEC_VERSION_OFFSET = sizeof(uint16_t) + sizeof(uint32_t);
+
+ClipPlugin::GlobalEvent MakeTestEvent()
+{
+    ClipPlugin::GlobalEvent event;
+    event.version = ClipPlugin::InfoType::TYPE_INDEX;
+    event.frameNum = 2;
+    event.user = 100;
+    event.seqId = 0xFFFE;
+    event.status = ClipPlugin::EVT_NORMAL;
+    event.syncTime = 12;
+    event.dataId = 34;
+    event.expiration = UINT64_MAX - 1;
+    event.isDelay = true;
+    event.notNeedLink = true;
+    event.deviceId = "deviceId";
+    event.account = "account";
+    event.dataType = { "text/plain", "text/html" };
+    return event;
+}
+} // namespace
+
+class GlobalEventCodecTest : public testing::Test {
+public:
+    GlobalEventCodecTest() {};
+    ~GlobalEventCodecTest() {};
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void GlobalEventCodecTest::SetUpTestCase(void) { }
+
+void GlobalEventCodecTest::TearDownTestCase(void) { }
+
+void GlobalEventCodecTest::SetUp(void) { }
+
+void GlobalEventCodecTest::TearDown(void) { }
+
+/**
+ * @tc.name: GlobalEventCodecBinaryTest001
+ * @tc.desc: new peers get the TLV frame and every field round trips, unsigned ranges included
+ * @tc.type: FUNC
+ */
+HWTEST_F(GlobalEventCodecTest, GlobalEventCodecBinaryTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GlobalEventCodecBinaryTest001 start");
+    auto event = MakeTestEvent();
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(GlobalEventCodec::Encode(event, NEW_PEER_VERSION, buffer));
+    EXPECT_TRUE(GlobalEventCodec::IsBinary(buffer));
+    std::vector<uint8_t> json;
+    ASSERT_TRUE(GlobalEventCodec::Encode(event, OLD_PEER_VERSION, json));
+    EXPECT_LT(buffer.size(), json.size());
+
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(GlobalEventCodec::Decode(buffer, decoded));
+    EXPECT_EQ(decoded.version, event.version);
+    EXPECT_EQ(decoded.frameNum, event.frameNum);
+    EXPECT_EQ(decoded.user, event.user);
+    EXPECT_EQ(decoded.seqId, event.seqId);
+    EXPECT_EQ(decoded.status, event.status);
+    EXPECT_EQ(decoded.syncTime, event.syncTime);
+    EXPECT_EQ(decoded.dataId, event.dataId);
+    EXPECT_EQ(decoded.expiration, event.expiration);
+    EXPECT_EQ(decoded.isDelay, event.isDelay);
+    EXPECT_EQ(decoded.notNeedLink, event.notNeedLink);
+    EXPECT_EQ(decoded.deviceId, event.deviceId);
+    EXPECT_EQ(decoded.account, event.account);
+    EXPECT_EQ(decoded.dataType, event.dataType);
+
+    buffer.resize(buffer.size() - 1);
+    EXPECT_FALSE(GlobalEventCodec::Decode(buffer, decoded));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GlobalEventCodecBinaryTest001 end");
+}
+
+/**
+ * @tc.name: GlobalEventCodecJsonTest001
+ * @tc.desc: old peers get the JSON event and Decode still reads it
+ * @tc.type: FUNC
+ */
+HWTEST_F(GlobalEventCodecTest, GlobalEventCodecJsonTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GlobalEventCodecJsonTest001 start");
+    auto event = MakeTestEvent();
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(GlobalEventCodec::Encode(event, OLD_PEER_VERSION, buffer));
+    EXPECT_FALSE(GlobalEventCodec::IsBinary(buffer));
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(GlobalEventCodec::Decode(buffer, decoded));
+    EXPECT_EQ(decoded.seqId, event.seqId);
+    EXPECT_EQ(decoded.deviceId, event.deviceId);
+    EXPECT_EQ(decoded.dataType, event.dataType);
+    EXPECT_FALSE(GlobalEventCodec::Decode({}, decoded));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GlobalEventCodecJsonTest001 end");
+}
+
+/**
+ * @tc.name: GlobalEventCodecVersionTest001
+ * @tc.desc: frames of an unknown codec version are refused instead of read with the local layout
+ * @tc.type: FUNC
+ */
+HWTEST_F(GlobalEventCodecTest, GlobalEventCodecVersionTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GlobalEventCodecVersionTest001 start");
+    auto event = MakeTestEvent();
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(GlobalEventCodec::Encode(event, NEW_PEER_VERSION, buffer));
+    ASSERT_GT(buffer.size(), CODEC_VERSION_OFFSET);
+    ClipPlugin::GlobalEvent decoded;
+    buffer[CODEC_VERSION_OFFSET] = static_cast<uint8_t>(GlobalEventCodec::CODEC_VERSION + 1);
+    EXPECT_TRUE(GlobalEventCodec::IsBinary(buffer));
+    EXPECT_FALSE(GlobalEventCodec::Decode(buffer, decoded));
+    buffer[CODEC_VERSION_OFFSET] = 0;
+    EXPECT_FALSE(GlobalEventCodec::Decode(buffer, decoded));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GlobalEventCodecVersionTest001 end");
+}
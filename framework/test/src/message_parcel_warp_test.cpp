@@ -273,6 +273,59 @@ HWTEST_F(MessageParcelWarpTest, WriteRawDataTest004, TestSize.Level0)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "WriteRawDataTest004 end");
 }
 
+/**
+ * @tc.name: WriteRawDataTest005
+ * @tc.desc: Test WriteRawData fills the ashmem in place through the writer
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MessageParcelWarpTest, WriteRawDataTest005, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "WriteRawDataTest005 start");
+    MessageParcelWarp messageParcelWarp;
+    MessageParcel parcel;
+    size_t size = MIN_RAW_SIZE + 1;
+
+    NiceMock<MessageParcelWarpMock> mock;
+    EXPECT_CALL(mock, WriteInt64).WillOnce(testing::Return(true));
+    EXPECT_CALL(mock, WriteFileDescriptor).WillOnce(testing::Return(true));
+
+    size_t written = 0;
+    auto result = messageParcelWarp.WriteRawData(parcel, size, [&written](void *data, size_t len) {
+        auto *bytes = static_cast<uint8_t *>(data);
+        EXPECT_EQ(bytes[0], 0);
+        EXPECT_EQ(bytes[len - 1], 0);
+        std::fill(bytes, bytes + len, 'A');
+        written = len;
+        return true;
+    });
+    EXPECT_TRUE(result);
+    EXPECT_EQ(written, size);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "WriteRawDataTest005 end");
+}
+
+/**
+ * @tc.name: WriteRawDataTest006
+ * @tc.desc: Test WriteRawData fails when the writer fails
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MessageParcelWarpTest, WriteRawDataTest006, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "WriteRawDataTest006 start");
+    MessageParcelWarp messageParcelWarp;
+    MessageParcel parcel;
+    size_t size = MIN_RAW_SIZE - 1;
+
+    NiceMock<MessageParcelWarpMock> mock;
+    EXPECT_CALL(mock, WriteInt64).WillOnce(testing::Return(true));
+    EXPECT_CALL(mock, WriteUnpadBuffer).Times(0);
+
+    auto result = messageParcelWarp.WriteRawData(parcel, size, [](void *data, size_t len) { return false; });
+    EXPECT_FALSE(result);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "WriteRawDataTest006 end");
+}
+
 /**
  * @tc.name: ReadRawDataTest001
  * @tc.desc: Test ReadRawData
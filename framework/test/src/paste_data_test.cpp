@@ -2210,4 +2210,276 @@ HWTEST_F(PasteDataTest, GetPasteIdDefaultTest001, TestSize.Level0)
     EXPECT_EQ("", pasteData.GetPasteId());
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetPasteIdDefaultTest001 end");
 }
+
+/**
+ * @tc.name: EncodeRecordsTest001
+ * @tc.desc: concatenation of EncodeWithoutRecords and EncodeRecords decodes to the same PasteData
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, EncodeRecordsTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EncodeRecordsTest001 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("test text");
+    pasteData.AddHtmlRecord("<p>test html</p>");
+    pasteData.SetPasteId("paste_id");
+    pasteData.SetDataId(10);
+
+    std::vector<uint8_t> header;
+    std::vector<uint8_t> records;
+    ASSERT_TRUE(pasteData.EncodeWithoutRecords(header));
+    ASSERT_TRUE(pasteData.EncodeRecords(records));
+    std::vector<uint8_t> full;
+    ASSERT_TRUE(pasteData.Encode(full));
+    EXPECT_EQ(header.size() + records.size(), full.size());
+
+    header.insert(header.end(), records.begin(), records.end());
+    PasteData decoded;
+    ASSERT_TRUE(decoded.Decode(header));
+    EXPECT_EQ(decoded.GetRecordCount(), 2);
+    EXPECT_EQ(decoded.GetPasteId(), "paste_id");
+    EXPECT_EQ(decoded.GetDataId(), 10);
+    auto text = decoded.GetPrimaryText();
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(*text, "test text");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EncodeRecordsTest001 end");
+}
+
+/**
+ * @tc.name: DecodeLazilyTest001
+ * @tc.desc: records decoded lazily are loaded on access and visited once loaded
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, DecodeLazilyTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest001 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("test text");
+    pasteData.AddHtmlRecord("<p>test html</p>");
+    pasteData.SetPasteId("paste_id");
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(pasteData.Encode(buffer));
+
+    PasteData lazyData;
+    ASSERT_TRUE(lazyData.DecodeLazily(buffer.data(), buffer.size()));
+    EXPECT_EQ(lazyData.GetRecordCount(), 2);
+    EXPECT_EQ(lazyData.GetPasteId(), "paste_id");
+
+    uint32_t visited = 0;
+    lazyData.VisitRecords([&visited](PasteDataRecord &) { visited++; });
+    EXPECT_EQ(visited, 0);
+    ASSERT_NE(lazyData.GetRecordAt(0), nullptr);
+    EXPECT_EQ(visited, 1);
+
+    PasteData copied(lazyData);
+    EXPECT_EQ(copied.AllRecords().size(), 2);
+    EXPECT_EQ(visited, 2);
+    auto text = copied.GetPrimaryText();
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(*text, "test text");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest001 end");
+}
+
+/**
+ * @tc.name: DecodeLazilyTest002
+ * @tc.desc: re-encoding a lazily decoded PasteData keeps the pending records
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, DecodeLazilyTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest002 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("text1");
+    pasteData.AddTextRecord("text2");
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(pasteData.Encode(buffer));
+    EXPECT_FALSE(pasteData.DecodeLazily(nullptr, buffer.size()));
+
+    PasteData lazyData;
+    ASSERT_TRUE(lazyData.DecodeLazily(buffer.data(), buffer.size()));
+    ASSERT_NE(lazyData.GetRecordAt(1), nullptr);
+    std::vector<uint8_t> reencoded;
+    ASSERT_TRUE(lazyData.Encode(reencoded));
+
+    PasteData decoded;
+    ASSERT_TRUE(decoded.Decode(reencoded));
+    ASSERT_EQ(decoded.GetRecordCount(), 2);
+    auto text = decoded.GetRecordAt(0)->GetPlainText();
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(*text, "text2");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest002 end");
+}
+
+/**
+ * @tc.name: DecodeLazilyTest003
+ * @tc.desc: a record with broken field framing fails the lazy decode up front
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, DecodeLazilyTest003, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest003 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("text1");
+    pasteData.AddTextRecord("text2");
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(pasteData.Encode(buffer));
+
+    PasteData lazyData;
+    ASSERT_TRUE(lazyData.DecodeLazily(buffer.data(), buffer.size()));
+    ASSERT_EQ(lazyData.lazyRecords_.size(), 2);
+    // The first field of record 0 claims more bytes than the record holds.
+    size_t lenOffset = lazyData.lazyRecords_[0].offset + sizeof(uint16_t);
+    std::fill_n(buffer.begin() + lenOffset, sizeof(uint32_t), UINT8_MAX);
+
+    PasteData brokenData;
+    EXPECT_FALSE(brokenData.DecodeLazily(buffer.data(), buffer.size()));
+    EXPECT_EQ(brokenData.lazyBuffer_, nullptr);
+    EXPECT_EQ(brokenData.GetRecordCount(), 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest003 end");
+}
+
+/**
+ * @tc.name: DecodeLazilyTest004
+ * @tc.desc: decoding from a shared buffer keeps that buffer instead of copying it
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, DecodeLazilyTest004, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest004 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("text1");
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    ASSERT_TRUE(pasteData.Encode(*buffer));
+    size_t size = buffer->size();
+    std::shared_ptr<const uint8_t> owner(buffer, buffer->data());
+    buffer = nullptr;
+
+    PasteData lazyData;
+    ASSERT_TRUE(lazyData.DecodeLazily(owner, size));
+    EXPECT_EQ(lazyData.lazyBuffer_.get(), owner.get());
+    owner = nullptr;
+    auto text = lazyData.GetPrimaryText();
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(*text, "text1");
+    EXPECT_EQ(lazyData.PeekRecords().size(), 1);
+    EXPECT_EQ(lazyData.lazyBuffer_, nullptr);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DecodeLazilyTest004 end");
+}
+
+/**
+ * @tc.name: ShareFromTest001
+ * @tc.desc: records shared by ShareFrom are copied on write by MutableRecordAt
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, ShareFromTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ShareFromTest001 start");
+    PasteData pasteData;
+    pasteData.AddUriRecord(OHOS::Uri("file://pasteboard/share_from"));
+    pasteData.AddTextRecord("text");
+    pasteData.GetRecordAt(1)->SetConvertUri("origin");
+
+    PasteData snapshot;
+    snapshot.ShareFrom(pasteData);
+    ASSERT_EQ(snapshot.GetRecordCount(), 2);
+    EXPECT_EQ(snapshot.GetRecordAt(0), pasteData.GetRecordAt(0));
+    EXPECT_EQ(snapshot.GetRecordAt(1), pasteData.GetRecordAt(1));
+
+    auto record = snapshot.MutableRecordAt(1);
+    ASSERT_NE(record, nullptr);
+    record->SetConvertUri("");
+    EXPECT_NE(record, pasteData.GetRecordAt(1));
+    EXPECT_EQ(pasteData.GetRecordAt(1)->GetConvertUri(), "origin");
+    EXPECT_EQ(snapshot.GetRecordAt(0), pasteData.GetRecordAt(0));
+    EXPECT_EQ(snapshot.MutableRecordAt(2), nullptr);
+
+    pasteData.UnshareRecords();
+    EXPECT_NE(snapshot.GetRecordAt(0), pasteData.GetRecordAt(0));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ShareFromTest001 end");
+}
+
+/**
+ * @tc.name: TypeIndexTest001
+ * @tc.desc: the type index survives encoding and is dropped when records are added
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, TypeIndexTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TypeIndexTest001 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("test text");
+    pasteData.AddHtmlRecord("<p>test html</p>");
+    pasteData.BuildTypeIndex();
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(pasteData.Encode(buffer));
+
+    PasteData lazyData;
+    ASSERT_TRUE(lazyData.DecodeLazily(buffer.data(), buffer.size()));
+    EXPECT_TRUE(lazyData.HasMimeType(MIMETYPE_TEXT_PLAIN));
+    EXPECT_TRUE(lazyData.HasListedMimeType(MIMETYPE_TEXT_HTML));
+    EXPECT_FALSE(lazyData.HasMimeType(MIMETYPE_TEXT_URI));
+    EXPECT_EQ(lazyData.GetMimeTypes(), pasteData.GetMimeTypes());
+
+    lazyData.AddTextRecord("more text");
+    lazyData.AddUriRecord(OHOS::Uri("file://pasteboard/type_index"));
+    EXPECT_TRUE(lazyData.HasMimeType(MIMETYPE_TEXT_URI));
+    EXPECT_TRUE(lazyData.HasListedMimeType(MIMETYPE_TEXT_URI));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TypeIndexTest001 end");
+}
+
+/**
+ * @tc.name: TypeIndexTest002
+ * @tc.desc: the type index is dropped when records are handed out for writing and kept by the Peek accessors
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, TypeIndexTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TypeIndexTest002 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("test text");
+    pasteData.BuildTypeIndex();
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(pasteData.Encode(buffer));
+
+    PasteData decoded;
+    ASSERT_TRUE(decoded.Decode(buffer));
+    EXPECT_NE(decoded.GetTypeIndex(), nullptr);
+    EXPECT_FALSE(decoded.HasMimeType(MIMETYPE_TEXT_HTML));
+    auto record = decoded.GetRecordAt(0);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(decoded.GetTypeIndex(), nullptr);
+    std::string htmlText = "<p>test html</p>";
+    auto htmlUtdId = CommonUtils::Convert2UtdId(UDMF::UDType::UD_BUTT, MIMETYPE_TEXT_HTML);
+    record->AddEntryByMimeType(MIMETYPE_TEXT_HTML, std::make_shared<PasteDataEntry>(htmlUtdId, htmlText));
+    EXPECT_TRUE(decoded.HasMimeType(MIMETYPE_TEXT_HTML));
+
+    ASSERT_TRUE(decoded.Decode(buffer));
+    EXPECT_NE(decoded.PeekRecordAt(0), nullptr);
+    EXPECT_NE(decoded.PeekRecordById(record->GetRecordId()), nullptr);
+    EXPECT_EQ(decoded.PeekRecords().size(), 1);
+    EXPECT_NE(decoded.GetTypeIndex(), nullptr);
+    EXPECT_NE(decoded.GetRecordById(record->GetRecordId()), nullptr);
+    EXPECT_EQ(decoded.GetTypeIndex(), nullptr);
+
+    ASSERT_TRUE(decoded.Decode(buffer));
+    EXPECT_EQ(decoded.AllRecords().size(), 1);
+    EXPECT_EQ(decoded.GetTypeIndex(), nullptr);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TypeIndexTest002 end");
+}
 } // namespace OHOS::MiscServices
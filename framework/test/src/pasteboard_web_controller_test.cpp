@@ -358,6 +358,142 @@ HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgLabel_002, TestSize.Level1
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_002 end");
 }
 
+/**
+ * @tc.name: SplitHtmlWithImgLabel_003.
+ * @tc.desc: img tags in comments and scripts are skipped, and only real src attributes are taken.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgLabel_003, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_003 start");
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    std::string htmlText = "<!-- <img src=\"file:///a.png\"> --><script>'<img src=\"file:///b.png\">'</script>"
+        "<img data-src=\"file:///c.png\" src=\"file:///d.png\">";
+    auto html = std::make_shared<std::string>(htmlText);
+
+    auto result = webClipboardController.SplitHtmlWithImgLabel(html);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].second, htmlText.find("<img data-src"));
+
+    auto imgSrcMap = webClipboardController.SplitHtmlWithImgSrcLabel(result);
+    ASSERT_EQ(imgSrcMap.size(), 1u);
+    uint32_t offset = static_cast<uint32_t>(htmlText.find("file:///d.png"));
+    EXPECT_EQ(imgSrcMap["file:///d.png"], std::vector<uint8_t>({static_cast<uint8_t>(offset), 0, 0, 0}));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_003 end");
+}
+
+/**
+ * @tc.name: SplitHtmlWithImgLabel_004.
+ * @tc.desc: the img tag name must end with a space, '/' or '>'.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgLabel_004, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_004 start");
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    std::string htmlText = "<imgx src=\"file:///a.png\"><image src=\"file:///b.png\"><img/src=\"file:///c.png\">";
+    auto html = std::make_shared<std::string>(htmlText);
+
+    auto result = webClipboardController.SplitHtmlWithImgLabel(html);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].first, "<img/src=\"file:///c.png\">");
+    auto imgSrcMap = webClipboardController.SplitHtmlWithImgSrcLabel(result);
+    EXPECT_EQ(imgSrcMap.size(), 1u);
+    EXPECT_EQ(imgSrcMap.count("file:///c.png"), 1u);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_004 end");
+}
+
+/**
+ * @tc.name: SplitHtmlWithImgLabel_005.
+ * @tc.desc: tag and attribute names are matched case-insensitively.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgLabel_005, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_005 start");
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    std::string htmlText = "<IMG SRC=\"file:///a.png\"><Img Src='file:///b.png'>";
+    auto html = std::make_shared<std::string>(htmlText);
+
+    auto result = webClipboardController.SplitHtmlWithImgLabel(html);
+    ASSERT_EQ(result.size(), 2u);
+    auto imgSrcMap = webClipboardController.SplitHtmlWithImgSrcLabel(result);
+    EXPECT_EQ(imgSrcMap.size(), 2u);
+    EXPECT_EQ(imgSrcMap.count("file:///a.png"), 1u);
+    EXPECT_EQ(imgSrcMap.count("file:///b.png"), 1u);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_005 end");
+}
+
+/**
+ * @tc.name: SplitHtmlWithImgLabel_006.
+ * @tc.desc: a '>' inside a quoted attribute value does not end the tag.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgLabel_006, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_006 start");
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    std::string htmlText = "<img alt=\"a>b\" src=\"file:///a.png\">";
+    auto html = std::make_shared<std::string>(htmlText);
+
+    auto result = webClipboardController.SplitHtmlWithImgLabel(html);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].first, htmlText);
+    auto imgSrcMap = webClipboardController.SplitHtmlWithImgSrcLabel(result);
+    uint32_t offset = static_cast<uint32_t>(htmlText.find("file:///a.png"));
+    EXPECT_EQ(imgSrcMap["file:///a.png"], std::vector<uint8_t>({static_cast<uint8_t>(offset), 0, 0, 0}));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_006 end");
+}
+
+/**
+ * @tc.name: SplitHtmlWithImgLabel_007.
+ * @tc.desc: an img tag inside an attribute value of another tag is skipped.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgLabel_007, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_007 start");
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    std::string htmlText = "<a title=\"<img src='file:///a.png'>\">x</a><img src=\"file:///b.png\">";
+    auto html = std::make_shared<std::string>(htmlText);
+
+    auto result = webClipboardController.SplitHtmlWithImgLabel(html);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].second, htmlText.find("<img src=\"file:///b.png\">"));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_007 end");
+}
+
+/**
+ * @tc.name: SplitHtmlWithImgLabel_008.
+ * @tc.desc: img tags inside textarea and title content are skipped.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgLabel_008, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_008 start");
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    std::string htmlText = "<textarea><img src=\"file:///a.png\"></textarea>"
+        "<TITLE><img src=\"file:///b.png\"></title><img src=\"file:///c.png\">";
+    auto html = std::make_shared<std::string>(htmlText);
+
+    auto result = webClipboardController.SplitHtmlWithImgLabel(html);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].second, htmlText.find("<img src=\"file:///c.png\">"));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgLabel_008 end");
+}
+
 /**
  * @tc.name: SplitHtmlWithImgSrcLabel_001.
  * @tc.desc: mixed local and non-local src values keep only local entries.
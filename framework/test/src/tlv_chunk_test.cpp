@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "tlv_chunk.h"
+#include "pasteboard_hilog.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace OHOS::MiscServices;
+
+namespace {
+constexpr size_t TEST_DATA_SIZE = TLVChunkWriter::CHUNK_SIZE * 2 + 100;
+constexpr uint64_t TEST_MAX_SIZE = TLVChunkWriter::CHUNK_SIZE * 4;
+
+std::vector<uint8_t> MakeTestData(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i % UINT8_MAX);
+    }
+    return data;
+}
+} // namespace
+
+class TLVChunkTest : public testing::Test {
+public:
+    TLVChunkTest() {};
+    ~TLVChunkTest() {};
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void TLVChunkTest::SetUpTestCase(void) { }
+
+void TLVChunkTest::TearDownTestCase(void) { }
+
+void TLVChunkTest::SetUp(void) { }
+
+void TLVChunkTest::TearDown(void) { }
+
+/**
+ * @tc.name: TLVChunkRoundTripTest001
+ * @tc.desc: frames cut by the writer are put back together by the reader, resuming after a lost frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(TLVChunkTest, TLVChunkRoundTripTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TLVChunkRoundTripTest001 start");
+    auto expect = MakeTestData(TEST_DATA_SIZE);
+    TLVChunkWriter writer(MakeTestData(TEST_DATA_SIZE));
+    TLVChunkReader reader(TEST_MAX_SIZE);
+    std::vector<uint8_t> frame;
+
+    ASSERT_TRUE(writer.GetChunk(reader.GetNextOffset(), frame));
+    EXPECT_TRUE(TLVChunkReader::IsChunkFrame(frame));
+    ASSERT_TRUE(reader.Append(frame));
+    EXPECT_EQ(reader.GetTotalSize(), TEST_DATA_SIZE);
+    EXPECT_EQ(reader.GetNextOffset(), TLVChunkWriter::CHUNK_SIZE);
+
+    ASSERT_TRUE(writer.GetChunk(reader.GetNextOffset(), frame));
+    frame.back() ^= 0xFF;
+    EXPECT_FALSE(reader.Append(frame));
+    EXPECT_FALSE(reader.Append(frame));
+    EXPECT_EQ(reader.GetNextOffset(), TLVChunkWriter::CHUNK_SIZE);
+
+    while (!reader.IsComplete()) {
+        ASSERT_TRUE(writer.GetChunk(reader.GetNextOffset(), frame));
+        ASSERT_TRUE(reader.Append(frame));
+    }
+    EXPECT_FALSE(writer.GetChunk(TEST_DATA_SIZE, frame));
+    EXPECT_EQ(reader.TakeData(), expect);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TLVChunkRoundTripTest001 end");
+}
+
+/**
+ * @tc.name: TLVChunkTooLargeTest001
+ * @tc.desc: the reader refuses a clip above its limit before allocating it
+ * @tc.type: FUNC
+ */
+HWTEST_F(TLVChunkTest, TLVChunkTooLargeTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TLVChunkTooLargeTest001 start");
+    TLVChunkWriter writer(MakeTestData(TEST_DATA_SIZE));
+    TLVChunkReader reader(TLVChunkWriter::CHUNK_SIZE);
+    std::vector<uint8_t> frame;
+    ASSERT_TRUE(writer.GetChunk(0, frame));
+    EXPECT_FALSE(reader.Append(frame));
+    EXPECT_TRUE(reader.IsTooLarge());
+    EXPECT_FALSE(reader.IsComplete());
+    EXPECT_FALSE(reader.Append(std::vector<uint8_t>(sizeof(TLVChunkHead) - 1)));
+    EXPECT_FALSE(TLVChunkReader::IsChunkFrame(std::vector<uint8_t>(sizeof(TLVChunkHead) - 1)));
+    EXPECT_FALSE(TLVChunkReader::IsChunkFrame(MakeTestData(TEST_DATA_SIZE)));
+    EXPECT_TRUE(reader.TakeData().empty());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TLVChunkTooLargeTest001 end");
+}
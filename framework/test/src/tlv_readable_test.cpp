@@ -651,3 +651,32 @@ HWTEST_F(TLVReadableTest, ReadHeadInvalidLenTest001, TestSize.Level1)
     EXPECT_FALSE(res);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ReadHeadInvalidLenTest001 end");
 }
+
+/**
+ * @tc.name: ReadOnlyBufferViewTest001
+ * @tc.desc: test ReadOnlyBuffer reading directly from raw memory
+ * @tc.type: FUNC
+ */
+HWTEST_F(TLVReadableTest, ReadOnlyBufferViewTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ReadOnlyBufferViewTest001 start");
+    std::vector<std::uint8_t> buffer(sizeof(TLVHead) + sizeof(int32_t));
+    TLVHead *pHead = reinterpret_cast<TLVHead *>(buffer.data());
+    pHead->tag = HostToNet(static_cast<uint16_t>(1));
+    pHead->len = HostToNet(static_cast<uint32_t>(sizeof(int32_t)));
+    int32_t expect = HostToNet(static_cast<int32_t>(100));
+    memcpy_s(buffer.data() + sizeof(TLVHead), sizeof(int32_t), &expect, sizeof(int32_t));
+
+    ReadOnlyBuffer buff(buffer.data(), buffer.size());
+    TLVHead head;
+    ASSERT_TRUE(buff.ReadHead(head));
+    int32_t value = 0;
+    EXPECT_TRUE(buff.ReadValue(value, head));
+    EXPECT_EQ(value, 100);
+    EXPECT_FALSE(buff.IsEnough());
+
+    ReadOnlyBuffer nullBuff(nullptr, buffer.size());
+    EXPECT_FALSE(nullBuff.IsEnough());
+    EXPECT_FALSE(nullBuff.ReadHead(head));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ReadOnlyBufferViewTest001 end");
+}
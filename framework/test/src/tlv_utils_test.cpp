@@ -17,6 +17,7 @@
 #include "tlv_utils.h"
 #include "parcel.h"
 #include "pasteboard_hilog.h"
+#include "want.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -175,4 +176,32 @@ HWTEST_F(TLVUtilsTest, RawMemStructTest001, TestSize.Level1)
     EXPECT_EQ(rawMem.bufferLen, 0);
     EXPECT_EQ(rawMem.parcel, nullptr);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "RawMemStructTest001 end");
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.name: SizingContextTest001
+ * @tc.desc: test TLVSizingContext reuses parcelable encodings only while the context is alive
+ * @tc.type: FUNC
+ */
+HWTEST_F(TLVUtilsTest, SizingContextTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SizingContextTest001 start");
+    auto want = std::make_shared<OHOS::AAFwk::Want>();
+    want->SetParam("key", std::string("value"));
+    RawMem found;
+    {
+        TLVSizingContext sizingContext;
+        RawMem first = TLVSizingContext::GetParcelable(want);
+        RawMem second = TLVSizingContext::GetParcelable(want);
+        EXPECT_NE(first.bufferLen, 0);
+        EXPECT_EQ(first.buffer, second.buffer);
+        EXPECT_EQ(first.parcel, second.parcel);
+        EXPECT_TRUE(TLVSizingContext::FindParcelable(want.get(), found));
+        EXPECT_EQ(found.buffer, first.buffer);
+    }
+    EXPECT_FALSE(TLVSizingContext::FindParcelable(want.get(), found));
+    RawMem first = TLVSizingContext::GetParcelable(want);
+    RawMem second = TLVSizingContext::GetParcelable(want);
+    EXPECT_NE(first.parcel, second.parcel);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SizingContextTest001 end");
+}
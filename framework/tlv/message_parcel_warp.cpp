@@ -123,12 +123,12 @@ bool MessageParcelWarp::MemcpyData(void *ptr, size_t size, const void *data, siz
     return true;
 }
 
-bool MessageParcelWarp::WriteRawData(MessageParcel &parcelPata, const void *data, size_t size)
+bool MessageParcelWarp::WriteRawDataSize(MessageParcel &parcelPata, bool hasData, size_t size)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(canWrite_, false,
         PASTEBOARD_MODULE_COMMON, "is already write, size:%{public}zu", size);
     canWrite_ = false;
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr, false, PASTEBOARD_MODULE_COMMON, "data is null");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(hasData, false, PASTEBOARD_MODULE_COMMON, "data is null");
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < size && static_cast<int64_t>(size) <= maxRawDataSize_, false,
         PASTEBOARD_MODULE_COMMON, "size invalid, size:%{public}zu", size);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(kernelMappedWrite_ == nullptr, false,
@@ -137,10 +137,42 @@ bool MessageParcelWarp::WriteRawData(MessageParcel &parcelPata, const void *data
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "data WriteInt64 failed end.");
         return false;
     }
+    return true;
+}
+
+bool MessageParcelWarp::WriteRawData(MessageParcel &parcelPata, const void *data, size_t size)
+{
+    if (!WriteRawDataSize(parcelPata, data != nullptr, size)) {
+        return false;
+    }
     if (size <= MIN_RAW_SIZE) {
         rawDataSize_ = size;
         return parcelPata.WriteUnpadBuffer(data, size);
     }
+    return WriteAshmem(parcelPata, size, [this, data](void *ptr, size_t len) {
+        return MemcpyData(ptr, len, data, len);
+    });
+}
+
+bool MessageParcelWarp::WriteRawData(MessageParcel &parcelPata, size_t size,
+    const std::function<bool(void *, size_t)> &writer)
+{
+    if (!WriteRawDataSize(parcelPata, writer != nullptr, size)) {
+        return false;
+    }
+    if (size <= MIN_RAW_SIZE) {
+        std::vector<uint8_t> buffer(size);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(writer(buffer.data(), size), false,
+            PASTEBOARD_MODULE_COMMON, "write raw data failed, size:%{public}zu", size);
+        rawDataSize_ = size;
+        return parcelPata.WriteUnpadBuffer(buffer.data(), size);
+    }
+    return WriteAshmem(parcelPata, size, writer);
+}
+
+bool MessageParcelWarp::WriteAshmem(MessageParcel &parcelPata, size_t size,
+    const std::function<bool(void *, size_t)> &writer)
+{
     int fd = AshmemCreate("Pasteboard Ashmem", size);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, false, PASTEBOARD_MODULE_COMMON, "ashmem create failed");
     
@@ -160,8 +192,8 @@ bool MessageParcelWarp::WriteRawData(MessageParcel &parcelPata, const void *data
         ::munmap(ptr, size);
         return false;
     }
-    if (!MemcpyData(ptr, size, data, size)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "memcpy_s failed, fd:%{public}d size:%{public}zu", fd, size);
+    if (!writer(ptr, size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "write ashmem failed, fd:%{public}d size:%{public}zu", fd, size);
         ::munmap(ptr, size);
         return false;
     }
@@ -16,6 +16,8 @@
 #ifndef MESSAGE_PARCEL_WARP_H
 #define MESSAGE_PARCEL_WARP_H
 
+#include <functional>
+
 #include "api/visibility.h"
 #include "message_parcel.h"
 
@@ -30,6 +32,8 @@ public:
     ~MessageParcelWarp();
 
     bool WriteRawData(MessageParcel &parcelPata, const void *data, size_t size);
+    // Lets writer fill the size bytes in place, for ashmem sizes it writes straight into the zeroed mapping.
+    bool WriteRawData(MessageParcel &parcelPata, size_t size, const std::function<bool(void *, size_t)> &writer);
     const void *ReadRawData(MessageParcel &parcelData, size_t size);
     static int64_t GetRawDataSize();
     int CreateTmpFd();
@@ -37,6 +41,9 @@ public:
     bool MemcpyData(void *ptr, size_t size, const void *data, size_t count);
 
 private:
+    bool WriteRawDataSize(MessageParcel &parcelPata, bool hasData, size_t size);
+    bool WriteAshmem(MessageParcel &parcelPata, size_t size, const std::function<bool(void *, size_t)> &writer);
+
     std::shared_ptr<char> rawData_ = nullptr;
     int writeRawDataFd_ = -1;
     int readRawDataFd_ = -1;
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tlv_chunk.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+
+#include "endian_converter.h"
+#include "pasteboard_hilog.h"
+#include "securec.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr uint32_t CRC32_POLY = 0xEDB88320;
+constexpr uint32_t CRC32_INIT = 0xFFFFFFFF;
+constexpr size_t CRC32_TABLE_SIZE = 256;
+constexpr uint32_t BITS_PER_BYTE = 8;
+
+constexpr std::array<uint32_t, CRC32_TABLE_SIZE> MakeCrc32Table()
+{
+    std::array<uint32_t, CRC32_TABLE_SIZE> table{};
+    for (uint32_t i = 0; i < CRC32_TABLE_SIZE; ++i) {
+        uint32_t crc = i;
+        for (uint32_t bit = 0; bit < BITS_PER_BYTE; ++bit) {
+            crc = (crc & 1) != 0 ? (crc >> 1) ^ CRC32_POLY : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr auto CRC32_TABLE = MakeCrc32Table();
+} // namespace
+
+TLVChunkWriter::TLVChunkWriter(std::vector<uint8_t> &&data) : data_(std::move(data)) {}
+
+const std::vector<uint8_t> &TLVChunkWriter::GetData() const
+{
+    return data_;
+}
+
+bool TLVChunkWriter::GetChunk(uint64_t offset, std::vector<uint8_t> &frame) const
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(offset < data_.size() || (offset == 0 && data_.empty()), false,
+        PASTEBOARD_MODULE_COMMON, "offset out of range, offset=%{public}" PRIu64 ", total=%{public}zu",
+        offset, data_.size());
+    size_t len = std::min(static_cast<size_t>(CHUNK_SIZE), data_.size() - static_cast<size_t>(offset));
+    const uint8_t *payload = data_.data() + offset;
+    TLVChunkHead head{};
+    head.magic = HostToNet(TLVChunkReader::CHUNK_MAGIC);
+    head.total = HostToNet(static_cast<uint64_t>(data_.size()));
+    head.offset = HostToNet(offset);
+    head.len = HostToNet(static_cast<uint32_t>(len));
+    head.crc = HostToNet(TLVChunkReader::Crc32(payload, len));
+    frame.resize(sizeof(head) + len);
+    auto ret = memcpy_s(frame.data(), frame.size(), &head, sizeof(head));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == EOK, false, PASTEBOARD_MODULE_COMMON, "copy head failed");
+    if (len > 0) {
+        ret = memcpy_s(frame.data() + sizeof(head), frame.size() - sizeof(head), payload, len);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == EOK, false, PASTEBOARD_MODULE_COMMON, "copy payload failed");
+    }
+    return true;
+}
+
+TLVChunkReader::TLVChunkReader(uint64_t maxSize) : maxSize_(maxSize) {}
+
+bool TLVChunkReader::Append(const std::vector<uint8_t> &frame)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(frame.size() >= sizeof(TLVChunkHead), false, PASTEBOARD_MODULE_COMMON,
+        "frame too short, size=%{public}zu", frame.size());
+    TLVChunkHead head{};
+    auto ret = memcpy_s(&head, sizeof(head), frame.data(), sizeof(head));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == EOK, false, PASTEBOARD_MODULE_COMMON, "copy head failed");
+    uint64_t total = NetToHost(head.total);
+    uint64_t offset = NetToHost(head.offset);
+    uint32_t len = NetToHost(head.len);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(NetToHost(head.magic) == CHUNK_MAGIC, false, PASTEBOARD_MODULE_COMMON,
+        "bad magic");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(frame.size() - sizeof(head) == len, false, PASTEBOARD_MODULE_COMMON,
+        "length mismatch, len=%{public}u, size=%{public}zu", len, frame.size());
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!started_ || total == total_, false, PASTEBOARD_MODULE_COMMON,
+        "total changed, total=%{public}" PRIu64 ", expect=%{public}" PRIu64, total, total_);
+    tooLarge_ = total > maxSize_;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!tooLarge_, false, PASTEBOARD_MODULE_COMMON,
+        "total too large, total=%{public}" PRIu64 ", max=%{public}" PRIu64, total, maxSize_);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(offset == next_ && len <= total - offset, false, PASTEBOARD_MODULE_COMMON,
+        "unexpected chunk, offset=%{public}" PRIu64 ", len=%{public}u, next=%{public}" PRIu64, offset, len, next_);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(len > 0 || total == 0, false, PASTEBOARD_MODULE_COMMON, "empty chunk");
+    const uint8_t *payload = frame.data() + sizeof(head);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(Crc32(payload, len) == NetToHost(head.crc), false,
+        PASTEBOARD_MODULE_COMMON, "checksum mismatch, offset=%{public}" PRIu64, offset);
+    if (!started_) {
+        started_ = true;
+        total_ = total;
+        data_.resize(static_cast<size_t>(total));
+    }
+    if (len > 0) {
+        ret = memcpy_s(data_.data() + offset, data_.size() - offset, payload, len);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == EOK, false, PASTEBOARD_MODULE_COMMON, "copy payload failed");
+    }
+    next_ += len;
+    return true;
+}
+
+uint64_t TLVChunkReader::GetNextOffset() const
+{
+    return next_;
+}
+
+uint64_t TLVChunkReader::GetTotalSize() const
+{
+    return total_;
+}
+
+bool TLVChunkReader::IsTooLarge() const
+{
+    return tooLarge_;
+}
+
+bool TLVChunkReader::IsComplete() const
+{
+    return started_ && next_ == total_;
+}
+
+std::vector<uint8_t> TLVChunkReader::TakeData()
+{
+    return std::move(data_);
+}
+
+bool TLVChunkReader::IsChunkFrame(const std::vector<uint8_t> &data)
+{
+    uint32_t magic = 0;
+    if (data.size() < sizeof(TLVChunkHead) || memcpy_s(&magic, sizeof(magic), data.data(), sizeof(magic)) != EOK) {
+        return false;
+    }
+    return NetToHost(magic) == CHUNK_MAGIC;
+}
+
+uint32_t TLVChunkReader::Crc32(const uint8_t *data, size_t len)
+{
+    uint32_t crc = CRC32_INIT;
+    for (size_t i = 0; i < len; ++i) {
+        crc = CRC32_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> BITS_PER_BYTE);
+    }
+    return crc ^ CRC32_INIT;
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_CHUNK_H
+#define DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_CHUNK_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/visibility.h"
+
+namespace OHOS::MiscServices {
+#pragma pack(1)
+struct TLVChunkHead {
+    uint32_t magic;
+    uint64_t total;
+    uint64_t offset;
+    uint32_t len;
+    uint32_t crc;
+};
+#pragma pack()
+
+/*
+ * Cuts one encoded clip into fixed-size frames for the chunked distributed transfer. Each frame carries the
+ * total size, its offset and a CRC32 of its payload, so the peer checks every frame on its own and asks again
+ * from the first missing offset after the link drops. Frames are cut on demand, the clip is held once.
+ * The first frame is the SetPasteData payload, the others are pulled as plugin entries of CHUNK_ENTRY_TYPE
+ * whose record id is the frame index.
+ */
+class API_EXPORT TLVChunkWriter {
+public:
+    static constexpr uint32_t CHUNK_SIZE = 256 * 1024;
+    static constexpr char CHUNK_ENTRY_TYPE[] = "openharmony.pasteboard-chunk";
+    explicit TLVChunkWriter(std::vector<uint8_t> &&data);
+
+    const std::vector<uint8_t> &GetData() const;
+    bool GetChunk(uint64_t offset, std::vector<uint8_t> &frame) const;
+
+private:
+    const std::vector<uint8_t> data_;
+};
+
+// Puts the frames of a TLVChunkWriter back together in one buffer, sized once from the first frame.
+class API_EXPORT TLVChunkReader {
+public:
+    explicit TLVChunkReader(uint64_t maxSize);
+
+    // Only takes the frame at GetNextOffset() with a matching checksum, anything else leaves the state untouched.
+    bool Append(const std::vector<uint8_t> &frame);
+    uint64_t GetNextOffset() const;
+    uint64_t GetTotalSize() const;
+    bool IsTooLarge() const;
+    bool IsComplete() const;
+    std::vector<uint8_t> TakeData();
+
+    static bool IsChunkFrame(const std::vector<uint8_t> &data);
+    static uint32_t Crc32(const uint8_t *data, size_t len);
+
+private:
+    static constexpr uint32_t CHUNK_MAGIC = 0x4B434250; // "PBCK"
+    friend class TLVChunkWriter;
+
+    const uint64_t maxSize_;
+    bool started_ = false;
+    bool tooLarge_ = false;
+    uint64_t total_ = 0;
+    uint64_t next_ = 0;
+    std::vector<uint8_t> data_;
+};
+} // namespace OHOS::MiscServices
+#endif // DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_CHUNK_H
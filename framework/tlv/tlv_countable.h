@@ -128,7 +128,7 @@ public:
             return 0;
         }
         size_t expectSize = sizeof(TLVHead);
-        return expectSize + Count(TLVUtils::Parcelable2Raw(value.get()));
+        return expectSize + Count(TLVSizingContext::GetParcelable(value));
     }
 
     static inline size_t Count(const std::shared_ptr<Media::PixelMap> value)
@@ -137,7 +137,7 @@ public:
             return 0;
         }
         size_t expectSize = sizeof(TLVHead);
-        return expectSize + Count(TLVUtils::PixelMap2Vector(value));
+        return expectSize + Count(*TLVSizingContext::GetPixelMap(value));
     }
 
     static inline size_t Count(const std::shared_ptr<Object> &value)
@@ -26,17 +26,41 @@ bool TLVReadable::Decode(const std::vector<std::uint8_t> &buffer)
     return DecodeTLV(buff);
 }
 
+bool TLVReadable::Decode(const uint8_t *data, size_t size)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr, false, PASTEBOARD_MODULE_COMMON, "data is null");
+    ReadOnlyBuffer buff(data, size);
+    return DecodeTLV(buff);
+}
+
 bool ReadOnlyBuffer::ReadHead(TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead)), false,
         PASTEBOARD_MODULE_COMMON, "read head failed");
-    const auto *pHead = reinterpret_cast<const TLVHead *>(data_.data() + cursor_);
+    const auto *pHead = reinterpret_cast<const TLVHead *>(data_ + cursor_);
     head.tag = NetToHost(pHead->tag);
     head.len = NetToHost(pHead->len);
     cursor_ += sizeof(TLVHead);
     return true;
 }
 
+bool ReadOnlyBuffer::ReadItemSpans(std::vector<std::pair<size_t, uint32_t>> &spans, const TLVHead &head)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(head.len), false,
+        PASTEBOARD_MODULE_COMMON, "read item spans failed, tag=%{public}hu", head.tag);
+    auto vectorEnd = cursor_ + head.len;
+    while (cursor_ < vectorEnd) {
+        TLVHead itemHead{};
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(vectorEnd - cursor_ >= sizeof(TLVHead) && ReadHead(itemHead), false,
+            PASTEBOARD_MODULE_COMMON, "read item head failed, tag=%{public}hu", head.tag);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(itemHead.len <= vectorEnd - cursor_, false, PASTEBOARD_MODULE_COMMON,
+            "item overflows vector, tag=%{public}hu, len=%{public}u", head.tag, itemHead.len);
+        spans.emplace_back(cursor_, itemHead.len);
+        cursor_ += itemHead.len;
+    }
+    return true;
+}
+
 bool ReadOnlyBuffer::ReadValue(std::monostate &value, const TLVHead &head)
 {
     (void)value;
@@ -90,7 +114,7 @@ bool ReadOnlyBuffer::ReadValue(std::string &value, const TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(head.len), false,
         PASTEBOARD_MODULE_COMMON, "read string failed, tag=%{public}hu", head.tag);
-    value.append(reinterpret_cast<const char *>(data_.data() + cursor_), head.len);
+    value.append(reinterpret_cast<const char *>(data_ + cursor_), head.len);
     cursor_ += head.len;
     return true;
 }
@@ -99,7 +123,7 @@ bool ReadOnlyBuffer::ReadValue(RawMem &rawMem, const TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(head.len), false,
         PASTEBOARD_MODULE_COMMON, "read RawMem failed, tag=%{public}hu", head.tag);
-    rawMem.buffer = (uintptr_t)(data_.data() + cursor_);
+    rawMem.buffer = (uintptr_t)(data_ + cursor_);
     rawMem.bufferLen = head.len;
     cursor_ += head.len;
     return true;
@@ -120,7 +144,7 @@ bool ReadOnlyBuffer::ReadValue(std::vector<uint8_t> &value, const TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(head.len), false,
         PASTEBOARD_MODULE_COMMON, "read vector failed, tag=%{public}hu", head.tag);
-    std::vector<uint8_t> buff(data_.data() + cursor_, data_.data() + cursor_ + head.len);
+    std::vector<uint8_t> buff(data_ + cursor_, data_ + cursor_ + head.len);
     value = std::move(buff);
     cursor_ += head.len;
     return true;
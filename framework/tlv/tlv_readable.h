@@ -32,14 +32,25 @@ public:
     virtual bool DecodeTLV(ReadOnlyBuffer &buffer) = 0;
 
     API_EXPORT bool Decode(const std::vector<uint8_t> &buffer);
+
+    // Decodes in place; the memory only has to stay valid until Decode returns.
+    API_EXPORT bool Decode(const uint8_t *data, size_t size);
 };
 
 class ReadOnlyBuffer : public TLVBuffer {
 public:
-    explicit ReadOnlyBuffer(const std::vector<uint8_t> &data) : TLVBuffer(data.size()), data_(data)
+    // Non-owning view, data must outlive the buffer.
+    explicit ReadOnlyBuffer(const std::vector<uint8_t> &data) : ReadOnlyBuffer(data.data(), data.size())
     {
     }
 
+    ReadOnlyBuffer(const uint8_t *data, size_t size) : TLVBuffer(data == nullptr ? 0 : size), data_(data),
+        size_(data == nullptr ? 0 : size)
+    {
+    }
+
+    explicit ReadOnlyBuffer(std::vector<uint8_t> &&data) = delete;
+
     template<typename T>
     bool ReadValue(std::vector<T> &value, const TLVHead &head)
     {
@@ -47,7 +58,7 @@ public:
             return false;
         }
         auto vectorEnd = cursor_ + head.len;
-        if (vectorEnd > data_.size()) {
+        if (vectorEnd > size_) {
             return false;
         }
         RecursiveGuard guard;
@@ -83,6 +94,8 @@ public:
     }
 
     bool ReadHead(TLVHead &head);
+    // Collects the [offset, offset + length) span of each vector item value without decoding it.
+    bool ReadItemSpans(std::vector<std::pair<size_t, uint32_t>> &spans, const TLVHead &head);
     bool ReadValue(std::monostate &value, const TLVHead &head);
     bool ReadValue(void *value, const TLVHead &head);
     bool ReadValue(bool &value, const TLVHead &head);
@@ -127,7 +140,7 @@ private:
             return false;
         }
         uint8_t rawValue = 0;
-        auto ret = memcpy_s(&rawValue, sizeof(bool), data_.data() + cursor_, sizeof(bool));
+        auto ret = memcpy_s(&rawValue, sizeof(bool), data_ + cursor_, sizeof(bool));
         if (ret != EOK) {
             return false;
         }
@@ -148,7 +161,7 @@ private:
         if (!HasExpectBuffer(head.len)) {
             return false;
         }
-        auto ret = memcpy_s(&value, sizeof(T), data_.data() + cursor_, sizeof(T));
+        auto ret = memcpy_s(&value, sizeof(T), data_ + cursor_, sizeof(T));
         if (ret != EOK) {
             return false;
         }
@@ -157,7 +170,8 @@ private:
         return true;
     }
 
-    const std::vector<uint8_t> data_;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
 };
 } // namespace OHOS::MiscServices
 #endif // DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_READABLE_H
@@ -15,10 +15,23 @@
 
 #include "tlv_utils.h"
 
+#include <unordered_map>
+
 #include "pasteboard_hilog.h"
 #include "pixel_map.h"
 
 namespace OHOS::MiscServices {
+namespace {
+struct SizingCache {
+    uint32_t depth = 0;
+    std::unordered_map<const void *, std::pair<std::shared_ptr<void>, std::shared_ptr<const std::vector<uint8_t>>>>
+        pixelMaps;
+    std::unordered_map<const void *, std::pair<std::shared_ptr<void>, RawMem>> parcelables;
+};
+
+thread_local SizingCache g_sizingCache;
+} // namespace
+
 RawMem TLVUtils::Parcelable2Raw(const Parcelable *value)
 {
     RawMem rawMem{};
@@ -77,4 +90,65 @@ std::vector<std::uint8_t> TLVUtils::PixelMap2Vector(std::shared_ptr<Media::Pixel
 
     return value;
 }
+
+TLVSizingContext::TLVSizingContext()
+{
+    g_sizingCache.depth++;
+}
+
+TLVSizingContext::~TLVSizingContext()
+{
+    if (--g_sizingCache.depth == 0) {
+        g_sizingCache.pixelMaps.clear();
+        g_sizingCache.parcelables.clear();
+    }
+}
+
+std::shared_ptr<const std::vector<std::uint8_t>> TLVSizingContext::GetPixelMap(
+    const std::shared_ptr<Media::PixelMap> &pixelMap)
+{
+    if (pixelMap == nullptr) {
+        return std::make_shared<const std::vector<std::uint8_t>>();
+    }
+    if (g_sizingCache.depth == 0) {
+        return std::make_shared<const std::vector<std::uint8_t>>(TLVUtils::PixelMap2Vector(pixelMap));
+    }
+    auto it = g_sizingCache.pixelMaps.find(pixelMap.get());
+    if (it != g_sizingCache.pixelMaps.end()) {
+        return it->second.second;
+    }
+    auto value = std::make_shared<const std::vector<std::uint8_t>>(TLVUtils::PixelMap2Vector(pixelMap));
+    g_sizingCache.pixelMaps.emplace(pixelMap.get(), std::make_pair(pixelMap, value));
+    return value;
+}
+
+std::shared_ptr<const std::vector<std::uint8_t>> TLVSizingContext::FindPixelMap(const Media::PixelMap *pixelMap)
+{
+    auto it = g_sizingCache.pixelMaps.find(pixelMap);
+    return it == g_sizingCache.pixelMaps.end() ? nullptr : it->second.second;
+}
+
+RawMem TLVSizingContext::GetParcelable(const std::shared_ptr<Parcelable> &value)
+{
+    if (value == nullptr || g_sizingCache.depth == 0) {
+        return TLVUtils::Parcelable2Raw(value.get());
+    }
+    auto it = g_sizingCache.parcelables.find(value.get());
+    if (it != g_sizingCache.parcelables.end()) {
+        return it->second.second;
+    }
+    RawMem rawMem = TLVUtils::Parcelable2Raw(value.get());
+    g_sizingCache.parcelables.emplace(value.get(), std::make_pair(value, rawMem));
+    return rawMem;
+}
+
+bool TLVSizingContext::FindParcelable(const Parcelable *value, RawMem &rawMem)
+{
+    auto it = g_sizingCache.parcelables.find(value);
+    if (it == g_sizingCache.parcelables.end()) {
+        return false;
+    }
+    rawMem = it->second.second;
+    return true;
+}
 } // namespace OHOS::MiscServices
@@ -52,6 +52,26 @@ public:
     static std::vector<std::uint8_t> PixelMap2Vector(std::shared_ptr<Media::PixelMap> pixelMap);
 };
 
+/*
+ * Memoizes PixelMap and Parcelable encodings on the current thread, so the CountTLV() pass and the
+ * following EncodeTLV() pass serialize each object only once. Entries are keyed by object address and
+ * keep the object alive, and the cache is dropped when the outermost context goes out of scope.
+ * Without an active context every call encodes afresh.
+ */
+class TLVSizingContext {
+public:
+    API_EXPORT TLVSizingContext();
+    API_EXPORT ~TLVSizingContext();
+    TLVSizingContext(const TLVSizingContext &) = delete;
+    TLVSizingContext &operator=(const TLVSizingContext &) = delete;
+
+    static std::shared_ptr<const std::vector<std::uint8_t>> GetPixelMap(
+        const std::shared_ptr<Media::PixelMap> &pixelMap);
+    static std::shared_ptr<const std::vector<std::uint8_t>> FindPixelMap(const Media::PixelMap *pixelMap);
+    static RawMem GetParcelable(const std::shared_ptr<Parcelable> &value);
+    static bool FindParcelable(const Parcelable *value, RawMem &rawMem);
+};
+
 class RecursiveGuard {
 public:
     RecursiveGuard()
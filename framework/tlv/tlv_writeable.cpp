@@ -31,10 +31,11 @@ bool IsRemoteEncode()
 bool TLVWriteable::Encode(std::vector<uint8_t> &buffer, bool isRemote) const
 {
     g_isRemoteEncode = isRemote;
+    TLVSizingContext sizingContext;
     size_t len = CountTLV();
     WriteOnlyBuffer buff(len);
     bool ret = EncodeTLV(buff);
-    buffer = std::move(buff.data_);
+    buffer = std::move(buff.owned_);
     return ret;
 }
 
@@ -47,12 +48,22 @@ size_t TLVWriteable::Count(bool isRemote) const
 bool TLVWriteable::Encode(size_t len, std::vector<uint8_t> &buffer, bool isRemote) const
 {
     g_isRemoteEncode = isRemote;
+    TLVSizingContext sizingContext;
     WriteOnlyBuffer buff(len);
     bool ret = EncodeTLV(buff);
-    buffer = std::move(buff.data_);
+    buffer = std::move(buff.owned_);
     return ret;
 }
 
+bool TLVWriteable::Encode(uint8_t *data, size_t len, bool isRemote) const
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr, false, PASTEBOARD_MODULE_COMMON, "data is null");
+    g_isRemoteEncode = isRemote;
+    TLVSizingContext sizingContext;
+    WriteOnlyBuffer buff(data, len);
+    return EncodeTLV(buff);
+}
+
 bool WriteOnlyBuffer::Write(uint16_t type, std::monostate value)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead)), false,
@@ -109,7 +120,7 @@ bool WriteOnlyBuffer::Write(uint16_t type, const std::string &value)
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead) + value.size()), false,
         PASTEBOARD_MODULE_COMMON, "write string failed, type=%{public}hu", type);
 
-    auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + cursor_);
+    auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + cursor_);
     tlvHead->tag = HostToNet(type);
     tlvHead->len = HostToNet(static_cast<uint32_t>(value.size()));
 
@@ -128,13 +139,13 @@ bool WriteOnlyBuffer::Write(uint16_t type, const RawMem &value)
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead) + value.bufferLen), false,
         PASTEBOARD_MODULE_COMMON, "write RawMem failed, type=%{public}hu", type);
 
-    auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + cursor_);
+    auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + cursor_);
     tlvHead->tag = HostToNet(type);
     tlvHead->len = HostToNet(static_cast<uint32_t>(value.bufferLen));
     cursor_ += sizeof(TLVHead);
 
     if (value.bufferLen != 0 && reinterpret_cast<const void *>(value.buffer) != nullptr) {
-        auto err = memcpy_s(data_.data() + cursor_, total_ - cursor_,
+        auto err = memcpy_s(data_ + cursor_, total_ - cursor_,
             reinterpret_cast<const void *>(value.buffer), value.bufferLen);
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(err == EOK, false, PASTEBOARD_MODULE_COMMON,
             "copy RawMem failed, type=%{public}hu, tgtSize=%{public}zu, srcSize=%{public}zu",
@@ -147,11 +158,19 @@ bool WriteOnlyBuffer::Write(uint16_t type, const RawMem &value)
 
 bool WriteOnlyBuffer::Write(uint16_t type, const AAFwk::Want &value)
 {
+    RawMem rawMem;
+    if (TLVSizingContext::FindParcelable(&value, rawMem)) {
+        return Write(type, rawMem);
+    }
     return Write(type, TLVUtils::Parcelable2Raw(&value));
 }
 
 bool WriteOnlyBuffer::Write(uint16_t type, const Media::PixelMap &value)
 {
+    auto cached = TLVSizingContext::FindPixelMap(&value);
+    if (cached != nullptr && !cached->empty()) {
+        return Write(type, *cached);
+    }
     std::vector<std::uint8_t> rawData;
     if (!value.EncodeTlv(rawData)) {
         return false;
@@ -295,7 +314,7 @@ bool WriteOnlyBuffer::Write(uint16_t type, const std::vector<uint8_t> &value)
     cursor_ += sizeof(TLVHead);
 
     if (!value.empty()) {
-        auto err = memcpy_s(data_.data() + cursor_, total_ - cursor_, value.data(), value.size());
+        auto err = memcpy_s(data_ + cursor_, total_ - cursor_, value.data(), value.size());
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(err == EOK, false, PASTEBOARD_MODULE_COMMON,
             "copy uint8 vector failed, type=%{public}hu, tgtSize=%{public}zu, srcSize=%{public}zu",
             type, total_ - cursor_, value.size());
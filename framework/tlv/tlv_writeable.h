@@ -35,15 +35,26 @@ public:
 
     API_EXPORT bool Encode(size_t len, std::vector<uint8_t> &buffer, bool isRemote = false) const;
 
+    // Encodes in place into len bytes of zero-filled memory, e.g. a freshly created shared memory mapping.
+    API_EXPORT bool Encode(uint8_t *data, size_t len, bool isRemote = false) const;
+
     API_EXPORT size_t Count(bool isRemote = false) const;
 };
 
 class WriteOnlyBuffer : public TLVBuffer {
 public:
-    explicit WriteOnlyBuffer(size_t len) : TLVBuffer(len), data_(len)
+    explicit WriteOnlyBuffer(size_t len) : TLVBuffer(len), owned_(len), data_(owned_.data())
     {
     }
 
+    // Non-owning, data must hold len zero-filled bytes and outlive the buffer.
+    WriteOnlyBuffer(uint8_t *data, size_t len) : TLVBuffer(data == nullptr ? 0 : len), data_(data)
+    {
+    }
+
+    WriteOnlyBuffer(const WriteOnlyBuffer &) = delete;
+    WriteOnlyBuffer &operator=(const WriteOnlyBuffer &) = delete;
+
     template<typename T>
     bool Write(uint16_t type, const std::vector<T> &value)
     {
@@ -101,10 +112,10 @@ public:
 private:
     void WriteHead(uint16_t type, size_t tagCursor, uint32_t len)
     {
-        if (tagCursor + sizeof(TLVHead) > data_.size()) {
+        if (tagCursor + sizeof(TLVHead) > total_) {
             return;
         }
-        auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + tagCursor);
+        auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + tagCursor);
         tlvHead->tag = HostToNet(type);
         tlvHead->len = HostToNet(len);
     }
@@ -115,7 +126,7 @@ private:
         if (!HasExpectBuffer(sizeof(TLVHead) + sizeof(value))) {
             return false;
         }
-        auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + cursor_);
+        auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + cursor_);
         tlvHead->tag = HostToNet(type);
         tlvHead->len = HostToNet(static_cast<uint32_t>(sizeof(value)));
         auto valueBuff = HostToNet(value);
@@ -140,7 +151,8 @@ private:
     }
 
     friend class TLVWriteable;
-    std::vector<uint8_t> data_;
+    std::vector<uint8_t> owned_;
+    uint8_t *data_ = nullptr;
 };
 } // namespace OHOS::MiscServices
 #endif // DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_WRITEABLE_H
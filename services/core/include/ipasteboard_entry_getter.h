@@ -18,6 +18,7 @@
 
 #include "iremote_broker.h"
 #include "paste_data_entry.h"
+#include "pasteboard_error.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -25,6 +26,17 @@ class IPasteboardEntryGetter : public IRemoteBroker {
 public:
     virtual ~IPasteboardEntryGetter() = default;
     virtual int32_t GetRecordValueByType(uint32_t recordId, PasteDataEntry &value) = 0;
+    // Fetches values[i] of recordIds[i] in one call, results[i] is its error code. The values stay within
+    // maxSize bytes, an entry that does not fit is left empty with EXCEEDING_LIMIT_EXCEPTION.
+    virtual int32_t GetRecordValuesByType(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+        std::vector<PasteDataEntry> &values, std::vector<int32_t> &results)
+    {
+        (void)recordIds;
+        (void)maxSize;
+        (void)values;
+        (void)results;
+        return static_cast<int32_t>(PasteboardError::NOT_SUPPORT);
+    }
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.misc.services.pasteboard.IPasteboardEntryGetter");
 };
 } // namespace MiscServices
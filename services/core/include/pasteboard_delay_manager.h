@@ -40,6 +40,12 @@ public:
 private:
     static uint8_t GetEntryPriority(const std::string &utdId);
     static void SortEntryInfo(std::vector<DelayEntryInfo> &entryInfos);
+    static std::vector<int32_t> FetchEntryValues(const std::vector<const DelayEntryInfo *> &entryInfos,
+        sptr<IPasteboardEntryGetter> entryGetter, int64_t maxSize, std::vector<PasteDataEntry> &values,
+        bool &batchSupported);
+    static void FetchEntryValuesOneByOne(const std::vector<const DelayEntryInfo *> &entryInfos,
+        sptr<IPasteboardEntryGetter> entryGetter, int64_t maxSize, std::vector<PasteDataEntry> &values,
+        std::vector<int32_t> &results);
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_ENTITY_RECOGNIZER_H
+#define PASTEBOARD_ENTITY_RECOGNIZER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "i_paste_data_processor.h"
+
+namespace OHOS {
+namespace MiscServices {
+// Runs entity recognition of copied text on one worker thread. The AI engine is loaded on first use, kept
+// while entity observers are subscribed and unloaded after an idle period or once the last observer leaves.
+// Texts submitted in quick succession are coalesced so that only the latest one is recognized.
+class PasteboardEntityRecognizer {
+public:
+    using ResultCallback = std::function<void(const std::string &text, const std::string &entity)>;
+    // Tells whether any entity observer is subscribed, called under the recognizer lock.
+    using ObserverQuery = std::function<bool()>;
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t processed = 0;
+        uint64_t engineLoads = 0;
+    };
+
+    // Subclasses overriding the engine hooks must call Stop in their own destructor.
+    virtual ~PasteboardEntityRecognizer();
+    void SetResultCallback(ResultCallback callback);
+    void SetObserverQuery(ObserverQuery query);
+    // Wakes the worker to check the observer query again once observers left.
+    void NotifyObserverChanged();
+    void Submit(const std::string &text);
+    void Stop();
+    Stats GetStats() const;
+
+protected:
+    virtual bool LoadEngine();
+    virtual void UnloadEngine();
+    virtual int32_t Process(const std::string &text, std::string &entity);
+
+private:
+    using GetProcessorFunc = IPasteDataProcessor &(*)();
+    using CleanupFunc = void (*)();
+    static constexpr uint32_t DEBOUNCE_TIME = 100;
+    static constexpr uint32_t MAX_DEBOUNCE_DELAY = 1000;
+    static constexpr uint32_t IDLE_UNLOAD_TIME = 60000;
+
+    void Run();
+    void WaitForQuiet(std::unique_lock<std::mutex> &lock);
+    void Recognize(const std::string &text, const ResultCallback &callback);
+    void ReleaseEngine();
+    bool HasObserverLocked() const;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+    bool running_ = false;
+    bool stop_ = false;
+    ObserverQuery observerQuery_;
+    bool hasPending_ = false;
+    uint64_t sequence_ = 0;
+    std::string pending_;
+    ResultCallback callback_;
+    Stats stats_;
+
+    // only touched by the worker thread
+    bool engineLoaded_ = false;
+    void *nluHandle_ = nullptr;
+    void *sslHandle_ = nullptr;
+    CleanupFunc cleanSSL_ = nullptr;
+    IPasteDataProcessor *processor_ = nullptr;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_ENTITY_RECOGNIZER_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_NOTIFY_EXECUTOR_H
+#define PASTEBOARD_NOTIFY_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "refbase.h"
+
+namespace OHOS {
+namespace MiscServices {
+// Delivers observer callbacks on a fixed set of worker threads. Each observer has its own FIFO queue and at
+// most one callback in flight, so a slow observer only delays itself. A task with the same coalesce key as the
+// last queued task of the observer is merged into it, so events are never reordered. An observer whose callback
+// has been running longer than the timeout gets new tasks dropped until it returns, as a remote call can not be
+// cancelled. A queue holds its observer, so a new observer never reuses the address of a queued one.
+class PasteboardNotifyExecutor {
+public:
+    struct Stats {
+        size_t pending = 0;
+        uint64_t dispatched = 0;
+        uint64_t coalesced = 0;
+        uint64_t dropped = 0;
+        uint64_t timeouts = 0;
+        uint64_t totalLatencyMs = 0;
+        uint64_t maxLatencyMs = 0;
+    };
+
+    PasteboardNotifyExecutor(size_t workerNum, size_t queueCapacity, uint64_t timeoutMs);
+    ~PasteboardNotifyExecutor();
+    void Post(const sptr<RefBase> &observer, const std::string &coalesceKey, std::function<void()> task);
+    Stats GetStats() const;
+
+private:
+    struct Task {
+        std::string coalesceKey;
+        std::function<void()> func;
+        uint64_t postTime = 0;
+    };
+    struct ObserverQueue {
+        sptr<RefBase> observer;
+        std::deque<Task> tasks;
+        bool running = false;
+        bool timedOut = false;
+        uint64_t startTime = 0;
+    };
+
+    void StartWorkersLocked();
+    void Work();
+    bool IsTimedOutLocked(ObserverQueue &queue, uint64_t now);
+
+    const size_t workerNum_;
+    const size_t queueCapacity_;
+    const uint64_t timeoutMs_;
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::map<const void *, ObserverQueue> queues_;
+    std::deque<const void *> ready_;
+    std::vector<std::thread> workers_;
+    bool stopped_ = false;
+    Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_NOTIFY_EXECUTOR_H
@@ -35,11 +35,10 @@ public:
     }
 
 private:
-    static std::string ExtractHtmlContent(const std::string &html_str);
+    static void DetectHtmlText(
+        std::set<Pattern> &patternsOut, const std::set<Pattern> &patternsIn, const std::string &html);
     static void DetectPlainText(
         std::set<Pattern> &patternsOut, const std::set<Pattern> &PatternsIn, const std::string &plainText);
-
-    static std::map<uint32_t, std::string> patterns_;
 };
 } // namespace OHOS::MiscServices
 #endif // PASTE_BOARD_PATTERN_H
\ No newline at end of file
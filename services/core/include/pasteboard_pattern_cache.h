@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_PATTERN_CACHE_H
+#define PASTEBOARD_PATTERN_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include "pasteboard_types.h"
+
+namespace OHOS {
+namespace MiscServices {
+// Remembers pattern detection results of the current clip of each user. Patterns are detected independently,
+// so a request is answered from the cache once all of its patterns were checked by earlier requests.
+class PasteboardPatternCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    bool Lookup(int32_t userId, uint32_t dataId, bool hasHTML, bool hasPlain, const std::set<Pattern> &patterns,
+        std::set<Pattern> &result);
+    // A result computed before the user's returned generation changed is stale and dropped by Store.
+    uint64_t GetGeneration(int32_t userId) const;
+    void Store(int32_t userId, uint32_t dataId, bool hasHTML, bool hasPlain, uint64_t generation,
+        const std::set<Pattern> &patterns, const std::set<Pattern> &result);
+    void Invalidate(int32_t userId);
+    Stats GetStats() const;
+
+private:
+    struct Detected {
+        uint32_t checked = 0;
+        uint32_t found = 0;
+    };
+    struct UserCache {
+        uint64_t generation = 0;
+        uint32_t dataId = 0;
+        // keyed by which text types the caller may read
+        std::map<uint32_t, Detected> detected;
+    };
+
+    static uint32_t ToMask(const std::set<Pattern> &patterns);
+    static uint32_t ToTextKey(bool hasHTML, bool hasPlain);
+
+    mutable std::mutex mutex_;
+    std::map<int32_t, UserCache> caches_;
+    Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_PATTERN_CACHE_H
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_REMOTE_EVENT_CACHE_H
+#define PASTEBOARD_REMOTE_EVENT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "clip/clip_plugin.h"
+#include "device/dm_adapter.h"
+
+namespace OHOS {
+namespace MiscServices {
+// Remembers the top distributed event of each user after the device-side checks (wifi, local network id,
+// peer online) passed, and the types of the latest remote clip. Everything is dropped when a peer goes
+// offline, wifi turns off, a new top event arrives or the distributed store changes.
+class PasteboardRemoteEventCache : public DMAdapter::DMObserver {
+public:
+    using Event = ClipPlugin::GlobalEvent;
+    enum class Stage : uint8_t {
+        NO_EVENT,
+        LOCAL_EVENT,
+        REMOTE_EVENT,
+    };
+    // utdTypes are only known when the peer sent a type frame.
+    struct RemoteTypes {
+        std::vector<std::string> mimeTypes;
+        std::vector<std::string> utdTypes;
+        bool hasUtdTypes = false;
+    };
+
+    bool GetEvent(int32_t user, Stage &stage, Event &event) const;
+    // An event validated before the returned generation changed is stale and dropped by Store.
+    uint64_t GetGeneration() const;
+    void StoreEvent(int32_t user, uint64_t generation, Stage stage, const Event &event);
+    bool GetTypes(const Event &event, RemoteTypes &types) const;
+    void StoreTypes(uint64_t generation, const Event &event, const RemoteTypes &types);
+    void Invalidate();
+
+    void Online(const std::string &device) override;
+    void Offline(const std::string &device) override;
+    void OnReady(const std::string &device) override;
+
+private:
+    struct CachedEvent {
+        Stage stage = Stage::NO_EVENT;
+        Event event;
+    };
+    struct CachedTypes {
+        bool valid = false;
+        std::string deviceId;
+        uint16_t seqId = 0;
+        uint32_t dataId = 0;
+        RemoteTypes types;
+    };
+
+    static bool IsSameClip(const CachedTypes &cached, const Event &event);
+
+    mutable std::mutex mutex_;
+    std::atomic<uint64_t> generation_ = 0;
+    std::map<int32_t, CachedEvent> events_;
+    CachedTypes types_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_REMOTE_EVENT_CACHE_H
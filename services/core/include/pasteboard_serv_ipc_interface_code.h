@@ -64,6 +64,7 @@ enum EntityObserverInterfaceCode {
 
 enum PasteboardEntryGetterInterfaceCode {
     GET_RECORD_VALUE_BY_TYPE = 0,
+    GET_RECORD_VALUES_BY_TYPE = 1,
 };
 } // namespace PasteboardServ
 } // namespace Security
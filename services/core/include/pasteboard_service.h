@@ -17,6 +17,7 @@
 #define PASTE_BOARD_SERVICE_H
 
 #include <atomic>
+#include <list>
 #include <system_ability_definition.h>
 
 #include "bundle_mgr_proxy.h"
@@ -25,7 +26,6 @@
 #include "device/distributed_module_config.h"
 #include "eventcenter/event_center.h"
 #include "ffrt/ffrt_utils.h"
-#include "i_paste_data_processor.h"
 #include "ientity_recognition_observer.h"
 #include "input_manager.h"
 #include "loader.h"
@@ -35,11 +35,18 @@
 #include "pasteboard_subprofile_subscriber.h"
 #endif
 #include "pasteboard_dump_helper.h"
+#include "pasteboard_entity_recognizer.h"
 #include "pasteboard_event_common.h"
 #include "paste_data_info.h"
+#include "pasteboard_notify_executor.h"
+#include "pasteboard_pattern_cache.h"
+#include "pasteboard_remote_event_cache.h"
 #include "pasteboard_service_stub.h"
+#include "pasteboard_set_pipeline.h"
 #include "pasteboard_switch.h"
+#include "pasteboard_uri_grant_ledger.h"
 #include "pasteboard_user_context.h"
+#include "pasteboard_user_lock.h"
 #include "privacy_kit.h"
 #include "security_level.h"
 #include "system_ability.h"
@@ -96,6 +103,8 @@ struct FocusedAppInfo {
 };
 
 class PasteboardService;
+class TLVChunkReader;
+class TLVChunkWriter;
 class InputEventCallback : public MMI::IInputEventConsumer {
 public:
     enum InputType : int32_t {
@@ -211,13 +220,10 @@ public:
     bool StartWith(const std::string &str, const std::string &prefix);
     int32_t CheckRemoteFileDocsUriLimit(const std::vector<Uri> &grantUris, const std::string &bundleName);
 
-    static std::shared_mutex pasteDataMutex_;
-
 private:
     std::atomic<bool> isCritical_ = false;
     std::mutex saMutex_;
     using Event = ClipPlugin::GlobalEvent;
-    using GetProcessorFunc = IPasteDataProcessor& (*)();
     static constexpr const int32_t LISTENING_SERVICE[] = { DISTRIBUTED_HARDWARE_DEVICEMANAGER_SA_ID,
         WINDOW_MANAGER_SERVICE_ID, MEMORY_MANAGER_SA_ID, DISTRIBUTED_DEVICE_PROFILE_SA_ID };
     static constexpr const char *PLUGIN_NAME = "distributed_clip";
@@ -237,6 +243,10 @@ private:
     static constexpr uint32_t GET_REMOTE_DATA_WAIT_TIME = 30000;
     static constexpr int64_t PRESYNC_MONITOR_INTERVAL_MILLISECONDS = 500; // ms
     static constexpr int32_t INVALID_SUBSCRIBE_ID = -1;
+    static constexpr size_t MAX_PENDING_SET_TASKS = 16;
+    static constexpr size_t NOTIFY_WORKER_NUM = 2;
+    static constexpr size_t MAX_PENDING_NOTIFY_TASKS = 8;
+    static constexpr uint64_t NOTIFY_TIMEOUT_MS = 1000;
     static const std::string REGISTER_PRESYNC_MONITOR;
     static const std::string UNREGISTER_PRESYNC_MONITOR;
     static const std::string P2P_ESTABLISH_STR;
@@ -322,6 +332,12 @@ private:
     std::string DumpUserHistory(int32_t userId) const;
     std::string DumpData();
     std::string DumpUserData(int32_t userId);
+    std::string DumpLockStats() const;
+    std::string DumpSetStats() const;
+    std::string DumpNotifyStats() const;
+    std::string DumpTimerStats() const;
+    std::string DumpPatternStats() const;
+    std::string DumpVersionStats();
     void ThawInputMethod(pid_t imePid);
     bool IsNeedThaw(PasteboardEventStatus status);
     int32_t ExtractEntity(const std::string &entity, std::string &location);
@@ -344,15 +360,37 @@ private:
         Event currentEvent;
     };
     DistributedMemory setDistributedMemory_;
+    // Encoded clip served frame by frame to peers pulling it through the chunked transfer.
+    struct DistributedChunkSource {
+        std::mutex mutex;
+        Event event;
+        std::shared_ptr<TLVChunkWriter> writer;
+    };
+    DistributedChunkSource chunkSource_;
+    // Checked frames of the last chunked clip that failed to arrive, the next paste of that event resumes after them.
+    struct DistributedChunkSink {
+        std::mutex mutex;
+        Event event;
+        int32_t syncTime = 0;
+        std::shared_ptr<TLVChunkReader> reader;
+    };
+    DistributedChunkSink chunkSink_;
 
     int32_t SaveData(PasteData &pasteData, int64_t dataSize, const sptr<IPasteboardDelayGetter> delayGetter = nullptr,
         const sptr<IPasteboardEntryGetter> entryGetter = nullptr);
+    // superseded is set when a later set of the same user was saved instead, its result is returned then.
+    int32_t SaveData(PasteData &pasteData, int64_t dataSize, const sptr<IPasteboardDelayGetter> delayGetter,
+        const sptr<IPasteboardEntryGetter> entryGetter, bool &superseded);
+    int32_t SaveDataInner(PasteData &pasteData, int64_t dataSize, const AppInfo &appInfo,
+        const sptr<IPasteboardDelayGetter> delayGetter, const sptr<IPasteboardEntryGetter> entryGetter);
     void SetPasteDataInfo(PasteData &pasteData, const AppInfo &appInfo);
     void HandleDelayDataAndRecord(PasteData &pasteData, const sptr<IPasteboardDelayGetter> delayGetter,
         const sptr<IPasteboardEntryGetter> entryGetter, const AppInfo &appInfo);
     void RemovePasteData(const AppInfo &appInfo);
     void SetPasteDataDot(PasteData &pasteData, const int32_t &userId);
     std::pair<int32_t, ClipPlugin::GlobalEvent> GetValidDistributeEvent(int32_t user);
+    int32_t ValidateTopEvent(const std::shared_ptr<ClipPlugin> &plugin, int32_t user,
+        PasteboardRemoteEventCache::Stage &stage, ClipPlugin::GlobalEvent &evt);
     int32_t GetSdkVersion(uint32_t tokenId);
     bool IsPermissionGranted(const std::string &perm, uint32_t tokenId);
     int32_t CheckAndGrantRemoteUri(PasteData &data, const AppInfo &appInfo,
@@ -388,9 +426,9 @@ private:
         PasteData &data, const std::pair<std::string, int32_t> &targetBundleAppIndex);
     void RemoveInvalidRemoteUri(std::vector<Uri> &grantUris);
     int32_t GrantPermission(const std::vector<Uri> &grantUris, uint32_t permFlag, bool isRemoteData,
-        uint32_t targetTokenId);
+        uint32_t targetTokenId, uint32_t dataId);
     int32_t GrantUriPermission(std::map<uint32_t, std::vector<Uri>> &grantUris,
-        uint32_t targetTokenId, bool isRemoteData);
+        uint32_t targetTokenId, bool isRemoteData, uint32_t dataId);
     void GenerateDistributedUri(PasteData &data);
     bool IsBundleOwnUriPermission(const std::string &bundleName, Uri &uri);
     std::string GetAppLabel(uint32_t tokenId);
@@ -411,6 +449,12 @@ private:
     int32_t GetDistributedDelayData(const Event &evt, uint8_t version, std::vector<uint8_t> &rawData);
     int32_t GetDistributedDelayEntry(const Event &evt, uint32_t recordId, const std::string &utdId,
         std::vector<uint8_t> &rawData);
+    std::pair<int32_t, int32_t> GetDistributedRawData(ClipPlugin &clipPlugin, const Event &event,
+        std::vector<uint8_t> &rawData);
+    int32_t GetDistributedChunk(const Event &evt, uint64_t offset, std::vector<uint8_t> &frame);
+    void SetDistributedChunkSource(const Event &event, std::shared_ptr<TLVChunkWriter> writer);
+    std::shared_ptr<TLVChunkReader> TakeDistributedChunkSink(const Event &event, int32_t &syncTime);
+    void KeepDistributedChunkSink(const Event &event, int32_t syncTime, std::shared_ptr<TLVChunkReader> reader);
     int32_t ProcessDistributedDelayUri(int32_t userId, PasteData &data, PasteDataEntry &entry,
         uint32_t recordId, std::vector<uint8_t> &rawData);
     int32_t ProcessDistributedDelayHtml(PasteData &data, PasteDataEntry &entry, std::vector<uint8_t> &rawData);
@@ -445,8 +489,7 @@ private:
     static std::string GetAppBundleName(const AppInfo &appInfo);
     static void SetLocalPasteFlag(bool isCrossPaste, uint32_t tokenId, PasteData &pasteData);
     void RecognizePasteData(PasteData &pasteData);
-    void OnRecognizePasteData(const std::string &primaryText);
-    void OnRecognizePasteDataInner(const std::string &primaryText, void *nulGuard);
+    void OnRecognizePasteData(const std::string &primaryText, const std::string &entity);
     void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
     void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
     void UpdateAgedTime();
@@ -468,6 +511,9 @@ private:
         const PasteDataEntry &entryValue);
     int32_t DealData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data);
     bool WriteRawData(const void *data, int64_t size, int &serFd);
+    bool WriteRawData(const std::vector<std::pair<const void *, int64_t>> &segments, int &serFd);
+    std::shared_ptr<const std::vector<uint8_t>> GetEncodedRecords(const PasteData &data);
+    void InvalidateEncodedClip(int32_t userId);
     int32_t WritePasteData(
         int fd, int64_t rawDataSize, const std::vector<uint8_t> &buffer, PasteData &pasteData, bool &hasData);
     void CloseSharedMemFd(int fd);
@@ -475,6 +521,9 @@ private:
     void SetDataExpirationTimer(int32_t userId);
     std::vector<uint8_t> EncodeMimeTypes(const std::vector<std::string> &mimeTypes);
     std::vector<std::string> DecodeMimeTypes(const std::vector<uint8_t> &rawData);
+    std::vector<uint8_t> EncodeRemoteMimeTypes(PasteData &data, size_t rawSize, uint32_t remoteVersion);
+    std::vector<uint8_t> EncodeTypeFrame(PasteData &data);
+    bool DecodeTypeFrame(const std::vector<uint8_t> &rawData, PasteDataTypeIndex &typeIndex);
 
     void InitPlugin(std::shared_ptr<ClipPlugin> clipPlugin);
     bool OpenP2PLinkForPreEstablish(const std::string &networkId, ClipPlugin *clipPlugin);
@@ -496,12 +545,29 @@ private:
     ClipPlugin::GlobalEvent currentEvent_;
     ClipPlugin::GlobalEvent remoteEvent_;
     ConcurrentMap<int32_t, std::shared_ptr<PasteData>> clips_;
+    // encoded records section of the local clip, reused by DealData until the clip changes
+    struct EncodedClip {
+        std::weak_ptr<PasteData> source;
+        uint32_t dataId = 0;
+        std::vector<std::string> convertUris;
+        std::shared_ptr<const std::vector<uint8_t>> records;
+    };
+    // one variant per set of convert uris, most recently used first, so paste targets do not evict each other
+    struct EncodedClips {
+        uint64_t epoch = 0;
+        std::list<EncodedClip> variants;
+    };
+    ConcurrentMap<int32_t, EncodedClips> encodedClips_;
     ConcurrentMap<int32_t, uint32_t> clipChangeCount_;
     ConcurrentMap<pid_t, std::vector<EntityObserverInfo>> entityObserverMap_;
     ConcurrentMap<int32_t, std::pair<sptr<IPasteboardEntryGetter>, sptr<EntryGetterDeathRecipient>>> entryGetters_;
     ConcurrentMap<int32_t, std::pair<sptr<IPasteboardDelayGetter>, sptr<DelayGetterDeathRecipient>>> delayGetters_;
     ConcurrentMap<int32_t, uint64_t> copyTime_;
     std::set<uint32_t> readBundles_;
+    PasteboardUriGrantLedger uriGrantLedger_;
+    PasteboardPatternCache patternCache_;
+    PasteboardEntityRecognizer entityRecognizer_;
+    PasteboardRemoteEventCache remoteEventCache_;
     std::shared_ptr<PasteBoardCommonEventSubscriber> commonEventSubscriber_ = nullptr;
     std::shared_ptr<PasteBoardAccountStateSubscriber> accountStateSubscriber_ = nullptr;
 #ifdef PB_COCKPIT_PLATFORM_ENABLE
@@ -522,7 +588,8 @@ private:
     static std::vector<std::string> dataHistory_;
     static std::shared_ptr<Command> copyHistory;
     static std::shared_ptr<Command> copyData;
-    std::atomic<bool> setting_ = false;
+    PasteboardSetPipeline setPipeline_{ MAX_PENDING_SET_TASKS };
+    PasteboardNotifyExecutor notifyExecutor_{ NOTIFY_WORKER_NUM, MAX_PENDING_NOTIFY_TASKS, NOTIFY_TIMEOUT_MS };
 
     struct PasteboardP2pInfo {
         pid_t callPid;
@@ -555,6 +622,8 @@ private:
     bool HasLocalDataType(const std::string &mimeType, uint32_t tokenId, int32_t userId);
     int32_t GetRemoteMimeTypes(std::vector<std::string> &mimeTypes, const Event &event);
     bool HasRemoteDataType(const std::string &mimeType, const Event &event);
+    int32_t GetRemoteTypes(PasteboardRemoteEventCache::RemoteTypes &types, const Event &event);
+    bool HasRemoteUtdType(const std::string &utdType, const Event &event, bool &hasType);
     void AddPermissionRecord(uint32_t tokenId, bool isReadGrant, bool isSecureGrant);
     bool SubscribeKeyboardEvent();
     bool IsConstraintEnabled(int32_t user);
@@ -578,7 +647,6 @@ private:
     static constexpr pid_t TEST_SERVER_UID = 3500;
     std::mutex eventMutex_;
     mutable std::mutex currentEventMutex_;
-    std::mutex entityRecognizeMutex_;
     SecurityLevel securityLevel_;
     class PasteboardDeathRecipient final : public IRemoteObject::DeathRecipient {
     public:
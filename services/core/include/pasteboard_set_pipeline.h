@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_SET_PIPELINE_H
+#define PASTEBOARD_SET_PIPELINE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace OHOS {
+namespace MiscServices {
+// Runs the SetPasteData tasks of each user one at a time, users do not wait for each other. A task that
+// has not started yet is superseded by a later task of the same user and does not run, since its data
+// would be overwritten right away; its caller waits for the later task and gets that result.
+class PasteboardSetPipeline {
+public:
+    struct Stats {
+        size_t depth = 0;
+        size_t maxDepth = 0;
+        uint64_t completed = 0;
+        uint64_t superseded = 0;
+        uint64_t rejected = 0;
+    };
+
+    // capacity bounds the callers of one user waiting for a task, each of them holds a binder thread.
+    explicit PasteboardSetPipeline(size_t capacity);
+    // superseded is set when a later task ran instead of this one, the return value is then its result.
+    int32_t Submit(int32_t userId, const std::function<int32_t()> &task, bool &superseded);
+    Stats GetStats() const;
+
+private:
+    struct Outcome {
+        bool done = false;
+        int32_t result = 0;
+    };
+    struct UserQueue {
+        std::condition_variable cond;
+        bool running = false;
+        // shared by the callers waiting for the next task, the latest of them runs it
+        std::shared_ptr<Outcome> next;
+        uint64_t nextTicket = 0;
+        size_t waiting = 0;
+    };
+
+    int32_t Run(UserQueue &queue, std::unique_lock<std::mutex> &lock, const std::function<int32_t()> &task);
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::map<int32_t, UserQueue> queues_;
+    uint64_t ticket_ = 0;
+    size_t depth_ = 0;
+    Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_SET_PIPELINE_H
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_URI_GRANT_LEDGER_H
+#define PASTEBOARD_URI_GRANT_LEDGER_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "uri.h"
+
+namespace OHOS {
+namespace MiscServices {
+// Remembers which uris of the current clip were granted to which paste target, so that pasting the same clip
+// into the same process again skips the grant calls. The target pid is part of the key because temporary
+// grants end with the process.
+class PasteboardUriGrantLedger {
+public:
+    struct Target {
+        uint32_t tokenId = 0;
+        pid_t pid = 0;
+        uint32_t permFlag = 0;
+        bool isRemote = false;
+
+        bool operator<(const Target &other) const
+        {
+            return std::tie(tokenId, pid, permFlag, isRemote) <
+                std::tie(other.tokenId, other.pid, other.permFlag, other.isRemote);
+        }
+    };
+
+    std::vector<Uri> FilterGranted(int32_t userId, uint32_t dataId, const Target &target,
+        const std::vector<Uri> &uris) const;
+    void Record(int32_t userId, uint32_t dataId, const Target &target, const std::vector<Uri> &uris);
+    void Forget(int32_t userId);
+    void ForgetToken(uint32_t tokenId);
+    void ForgetPid(pid_t pid);
+    size_t GetGrantedCount(int32_t userId) const;
+
+private:
+    struct UserLedger {
+        uint32_t dataId = 0;
+        std::map<Target, std::unordered_set<std::string>> granted;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<int32_t, UserLedger> ledgers_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_URI_GRANT_LEDGER_H
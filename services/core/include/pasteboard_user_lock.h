@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_USER_LOCK_H
+#define PASTEBOARD_USER_LOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+namespace OHOS {
+namespace MiscServices {
+// Guards the paste data of one user; users hashing to different shards never wait for each other.
+class PasteboardUserLock {
+public:
+    static std::unique_lock<std::shared_mutex> Write(int32_t userId);
+    static std::shared_lock<std::shared_mutex> Read(int32_t userId);
+    static uint64_t GetContention(int32_t userId);
+
+private:
+    struct Shard {
+        std::shared_mutex mutex;
+        std::atomic<uint64_t> contention = 0;
+    };
+    static constexpr uint32_t SHARD_COUNT = 16;
+    static Shard &GetShard(int32_t userId);
+};
+
+inline PasteboardUserLock::Shard &PasteboardUserLock::GetShard(int32_t userId)
+{
+    static Shard shards[SHARD_COUNT];
+    return shards[static_cast<uint32_t>(userId) % SHARD_COUNT];
+}
+
+inline std::unique_lock<std::shared_mutex> PasteboardUserLock::Write(int32_t userId)
+{
+    auto &shard = GetShard(userId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        shard.contention.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
+}
+
+inline std::shared_lock<std::shared_mutex> PasteboardUserLock::Read(int32_t userId)
+{
+    auto &shard = GetShard(userId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        shard.contention.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
+}
+
+inline uint64_t PasteboardUserLock::GetContention(int32_t userId)
+{
+    return GetShard(userId).contention.load(std::memory_order_relaxed);
+}
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_USER_LOCK_H
@@ -15,10 +15,15 @@
 
 #include "pasteboard_delay_manager.h"
 
+#include <algorithm>
+#include <condition_variable>
+
+#include "ffrt/ffrt_utils.h"
 #include "message_parcel_warp.h"
 #include "pasteboard_error.h"
 #include "pasteboard_hilog.h"
 #include "pasteboard_service.h"
+#include "pasteboard_user_lock.h"
 
 namespace OHOS::MiscServices {
 enum EntryPriority : uint8_t {
@@ -30,6 +35,9 @@ enum EntryPriority : uint8_t {
     PRIORITY_OTHERS = UINT8_MAX,
 };
 
+constexpr size_t ENTRY_FETCH_BATCH_SIZE = 32;
+constexpr size_t MAX_ENTRY_FETCH_HELPERS = 3;
+
 uint8_t DelayManager::GetEntryPriority(const std::string &utdId)
 {
     static std::string UTDID_PLAIN_TEXT = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::PLAIN_TEXT);
@@ -61,7 +69,7 @@ void DelayManager::SortEntryInfo(std::vector<DelayEntryInfo> &entryInfos)
 std::vector<DelayEntryInfo> DelayManager::GetAllDelayEntryInfo(const PasteData &data)
 {
     std::vector<DelayEntryInfo> delayEntryInfos;
-    for (const auto &record : data.AllRecords()) {
+    for (const auto &record : data.PeekRecords()) {
         if (record == nullptr || !record->IsDelayRecord()) {
             continue;
         }
@@ -78,7 +86,7 @@ std::vector<DelayEntryInfo> DelayManager::GetAllDelayEntryInfo(const PasteData &
 std::vector<DelayEntryInfo> DelayManager::GetPrimaryDelayEntryInfo(const PasteData &data)
 {
     std::vector<DelayEntryInfo> delayEntryInfos;
-    for (const auto &record : data.AllRecords()) {
+    for (const auto &record : data.PeekRecords()) {
         if (record == nullptr || !record->IsDelayRecord()) {
             continue;
         }
@@ -100,32 +108,127 @@ void DelayManager::GetLocalEntryValue(const std::vector<DelayEntryInfo> &delayEn
     sptr<IPasteboardEntryGetter> entryGetter, PasteData &data)
 {
     PASTEBOARD_CHECK_AND_RETURN_LOGE(entryGetter != nullptr, PASTEBOARD_MODULE_SERVICE, "entryGetter is null");
+    std::vector<const DelayEntryInfo *> pendingInfos;
     for (const auto &entryInfo : delayEntryInfos) {
         auto entry = entryInfo.entry;
-        if (entry == nullptr || !std::holds_alternative<std::monostate>(entry->GetValue())) {
-            continue;
+        if (entry != nullptr && std::holds_alternative<std::monostate>(entry->GetValue())) {
+            pendingInfos.push_back(&entryInfo);
+        }
+    }
+    bool batchSupported = true;
+    for (size_t begin = 0; begin < pendingInfos.size(); begin += ENTRY_FETCH_BATCH_SIZE) {
+        if (data.rawDataSize_ >= MessageParcelWarp::GetRawDataSize()) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "no space, dataSize=%{public}" PRId64, data.rawDataSize_);
+            break;
         }
+        size_t end = std::min(begin + ENTRY_FETCH_BATCH_SIZE, pendingInfos.size());
+        std::vector<const DelayEntryInfo *> chunk(pendingInfos.begin() + begin, pendingInfos.begin() + end);
+        std::vector<PasteDataEntry> values;
+        int64_t maxSize = MessageParcelWarp::GetRawDataSize() - data.rawDataSize_;
+        std::vector<int32_t> results = FetchEntryValues(chunk, entryGetter, maxSize, values, batchSupported);
 
-        PasteDataEntry tmpEntry = *entry;
-        int32_t result = entryGetter->GetRecordValueByType(entryInfo.recordId, tmpEntry);
-        if (result != static_cast<int32_t>(PasteboardError::E_OK)) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
-                "get record value fail, dataId=%{public}d, recordId=%{public}d, utdId=%{public}s",
-                data.GetDataId(), entryInfo.recordId, entry->GetUtdId().c_str());
-            continue;
+        // values are fetched without the lock, then committed in priority order under one lock
+        auto write = PasteboardUserLock::Write(data.GetUserId());
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            auto entry = chunk[i]->entry;
+            if (results[i] != static_cast<int32_t>(PasteboardError::E_OK)) {
+                PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
+                    "get record value fail, dataId=%{public}d, recordId=%{public}d, utdId=%{public}s",
+                    data.GetDataId(), chunk[i]->recordId, entry->GetUtdId().c_str());
+                continue;
+            }
+            const PasteDataEntry &tmpEntry = values[i];
+            if (data.rawDataSize_ + tmpEntry.rawDataSize_ < MessageParcelWarp::GetRawDataSize()) {
+                entry->SetValue(tmpEntry.GetValue());
+                entry->rawDataSize_ = tmpEntry.rawDataSize_;
+                data.rawDataSize_ += tmpEntry.rawDataSize_;
+                PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "add entry, dataSize=%{public}" PRId64
+                    ", entrySize=%{public}" PRId64, data.rawDataSize_, tmpEntry.rawDataSize_);
+            } else {
+                PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "no space, dataSize=%{public}" PRId64
+                    ", entrySize=%{public}" PRId64, data.rawDataSize_, tmpEntry.rawDataSize_);
+            }
+        }
+    }
+}
+
+std::vector<int32_t> DelayManager::FetchEntryValues(const std::vector<const DelayEntryInfo *> &entryInfos,
+    sptr<IPasteboardEntryGetter> entryGetter, int64_t maxSize, std::vector<PasteDataEntry> &values,
+    bool &batchSupported)
+{
+    std::vector<uint32_t> recordIds;
+    values.clear();
+    for (const auto *entryInfo : entryInfos) {
+        recordIds.push_back(entryInfo->recordId);
+        values.push_back(*entryInfo->entry);
+    }
+    std::vector<int32_t> results;
+    if (batchSupported) {
+        int32_t ret = entryGetter->GetRecordValuesByType(recordIds, maxSize, values, results);
+        if (ret == static_cast<int32_t>(PasteboardError::E_OK) && results.size() == entryInfos.size()) {
+            return results;
         }
+        // Only a getter without the batch call gives it up for good, other failures retry this chunk alone.
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "batch fetch failed, ret=%{public}d", ret);
+        batchSupported = ret != static_cast<int32_t>(PasteboardError::NOT_SUPPORT);
+        values.clear();
+        for (const auto *entryInfo : entryInfos) {
+            values.push_back(*entryInfo->entry);
+        }
+    }
+    FetchEntryValuesOneByOne(entryInfos, entryGetter, maxSize, values, results);
+    return results;
+}
 
-        if (data.rawDataSize_ + tmpEntry.rawDataSize_ < MessageParcelWarp::GetRawDataSize()) {
-            std::unique_lock<std::shared_mutex> write(PasteboardService::pasteDataMutex_);
-            entry->SetValue(tmpEntry.GetValue());
-            entry->rawDataSize_ = tmpEntry.rawDataSize_;
-            data.rawDataSize_ += tmpEntry.rawDataSize_;
-            PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "add entry, dataSize=%{public}" PRId64
-                ", entrySize=%{public}" PRId64, data.rawDataSize_, tmpEntry.rawDataSize_);
-        } else {
-            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "no space, dataSize=%{public}" PRId64
-                ", entrySize=%{public}" PRId64, data.rawDataSize_, tmpEntry.rawDataSize_);
+void DelayManager::FetchEntryValuesOneByOne(const std::vector<const DelayEntryInfo *> &entryInfos,
+    sptr<IPasteboardEntryGetter> entryGetter, int64_t maxSize, std::vector<PasteDataEntry> &values,
+    std::vector<int32_t> &results)
+{
+    results.assign(entryInfos.size(), static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION));
+    size_t total = entryInfos.size();
+    if (total == 0) {
+        return;
+    }
+    struct FetchState {
+        std::mutex mutex;
+        std::condition_variable cond;
+        size_t next = 0;
+        size_t done = 0;
+        int64_t remainSize = 0;
+    };
+    auto state = std::make_shared<FetchState>();
+    state->remainSize = maxSize;
+    // A helper that starts after every index is claimed returns at once, so it never touches the vectors.
+    auto fetch = [state, total, entryGetter, &entryInfos, &values, &results]() {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (state->next < total) {
+            size_t i = state->next++;
+            if (state->remainSize > 0) {
+                lock.unlock();
+                int32_t ret = entryGetter->GetRecordValueByType(entryInfos[i]->recordId, values[i]);
+                lock.lock();
+                results[i] = ret;
+                bool fetched = ret == static_cast<int32_t>(PasteboardError::E_OK);
+                if (fetched && values[i].rawDataSize_ < state->remainSize) {
+                    state->remainSize -= values[i].rawDataSize_;
+                } else if (fetched) {
+                    // only this entry is skipped, smaller ones after it may still fit
+                    values[i].SetValue(std::monostate{});
+                    results[i] = static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION);
+                }
+            }
+            if (++state->done == total) {
+                state->cond.notify_all();
+            }
         }
+    };
+    size_t helperNum = std::min(MAX_ENTRY_FETCH_HELPERS, total - 1);
+    for (size_t i = 0; i < helperNum; ++i) {
+        FFRTUtils::SubmitBlockingTask(fetch);
     }
+    // the caller fetches too, so the chunk completes even when every shared worker is busy
+    fetch();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cond.wait(lock, [&state, total] { return state->done == total; });
 }
 } // namespace OHOS::MiscServices
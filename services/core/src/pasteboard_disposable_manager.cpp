@@ -123,7 +123,7 @@ std::string DisposableManager::GetPlainText(PasteData &pasteData,
     auto iter = std::find(mimeTypes.begin(), mimeTypes.end(), MIMETYPE_TEXT_PLAIN);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(iter != mimeTypes.end(), allText, PASTEBOARD_MODULE_SERVICE, "no plain text");
 
-    for (auto record : pasteData.AllRecords()) {
+    for (auto record : pasteData.PeekRecords()) {
         if (record == nullptr) {
             continue;
         }
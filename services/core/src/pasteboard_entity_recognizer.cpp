@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_entity_recognizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <dlfcn.h>
+
+#include "common/pasteboard_common_utils.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr const char *NLU_SO_PATH = "libai_nlu_innerapi.z.so";
+constexpr const char *SSL_SO_PATH = "libcrypto_openssl.z.so";
+constexpr const char *GET_PASTE_DATA_PROCESSOR = "GetPasteDataProcessor";
+constexpr int32_t PROCESS_OK = 0;
+} // namespace
+
+PasteboardEntityRecognizer::~PasteboardEntityRecognizer()
+{
+    Stop();
+}
+
+void PasteboardEntityRecognizer::SetResultCallback(ResultCallback callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = std::move(callback);
+}
+
+void PasteboardEntityRecognizer::SetObserverQuery(ObserverQuery query)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    observerQuery_ = std::move(query);
+}
+
+void PasteboardEntityRecognizer::NotifyObserverChanged()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    cv_.notify_all();
+}
+
+bool PasteboardEntityRecognizer::HasObserverLocked() const
+{
+    return observerQuery_ != nullptr && observerQuery_();
+}
+
+void PasteboardEntityRecognizer::Submit(const std::string &text)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_ || !HasObserverLocked()) {
+        return;
+    }
+    pending_ = text;
+    hasPending_ = true;
+    sequence_++;
+    stats_.submitted++;
+    if (running_) {
+        cv_.notify_all();
+        return;
+    }
+    // a previous worker has already left Run once running_ is cleared
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    running_ = true;
+    worker_ = std::thread(&PasteboardEntityRecognizer::Run, this);
+    PasteBoardCommonUtils::SetThreadTaskName(worker_, "RecognizePaste");
+}
+
+void PasteboardEntityRecognizer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        cv_.notify_all();
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+PasteboardEntityRecognizer::Stats PasteboardEntityRecognizer::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void PasteboardEntityRecognizer::Run()
+{
+    PasteBoardCommonUtils::SetTaskName("PasteDataRecognize");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        while (true) {
+            cv_.wait_for(lock, std::chrono::milliseconds(IDLE_UNLOAD_TIME),
+                [this] { return stop_ || hasPending_ || !HasObserverLocked(); });
+            if (stop_ || !HasObserverLocked() || !hasPending_) {
+                break;
+            }
+            WaitForQuiet(lock);
+            if (stop_ || !HasObserverLocked()) {
+                break;
+            }
+            std::string text = std::move(pending_);
+            pending_.clear();
+            hasPending_ = false;
+            ResultCallback callback = callback_;
+            lock.unlock();
+            Recognize(text, callback);
+            lock.lock();
+        }
+        lock.unlock();
+        ReleaseEngine();
+        lock.lock();
+        if (stop_ || !HasObserverLocked() || !hasPending_) {
+            pending_.clear();
+            hasPending_ = false;
+            running_ = false;
+            return;
+        }
+    }
+}
+
+void PasteboardEntityRecognizer::WaitForQuiet(std::unique_lock<std::mutex> &lock)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(MAX_DEBOUNCE_DELAY);
+    uint64_t seen = sequence_;
+    while (!stop_ && std::chrono::steady_clock::now() < deadline) {
+        auto until = std::min(std::chrono::steady_clock::now() + std::chrono::milliseconds(DEBOUNCE_TIME), deadline);
+        if (!cv_.wait_until(lock, until, [this, seen] { return stop_ || sequence_ != seen; })) {
+            return;
+        }
+        seen = sequence_;
+    }
+}
+
+void PasteboardEntityRecognizer::Recognize(const std::string &text, const ResultCallback &callback)
+{
+    if (!engineLoaded_) {
+        engineLoaded_ = LoadEngine();
+        PASTEBOARD_CHECK_AND_RETURN_LOGE(engineLoaded_, PASTEBOARD_MODULE_SERVICE, "load AI engine failed");
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.engineLoads++;
+    }
+    std::string entity = "";
+    int32_t result = Process(text, entity);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.processed++;
+    }
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(
+        result == PROCESS_OK, PASTEBOARD_MODULE_SERVICE, "AI Process failed, result=%{public}d", result);
+    if (callback) {
+        callback(text, entity);
+    }
+}
+
+void PasteboardEntityRecognizer::ReleaseEngine()
+{
+    if (!engineLoaded_) {
+        return;
+    }
+    UnloadEngine();
+    engineLoaded_ = false;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "AI engine unloaded");
+}
+
+bool PasteboardEntityRecognizer::LoadEngine()
+{
+    nluHandle_ = dlopen(NLU_SO_PATH, RTLD_NOW);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(
+        nluHandle_ != nullptr, false, PASTEBOARD_MODULE_SERVICE, "Can not get AIEngine handle");
+    sslHandle_ = dlopen(SSL_SO_PATH, RTLD_NOW);
+    cleanSSL_ = sslHandle_ == nullptr ? nullptr : reinterpret_cast<CleanupFunc>(dlsym(sslHandle_, "OPENSSL_cleanup"));
+    auto getProcessor = reinterpret_cast<GetProcessorFunc>(dlsym(nluHandle_, GET_PASTE_DATA_PROCESSOR));
+    if (cleanSSL_ == nullptr || getProcessor == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Can not get SSL handle or ProcessorFunc");
+        UnloadEngine();
+        return false;
+    }
+    processor_ = &getProcessor();
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "AI engine loaded");
+    return true;
+}
+
+void PasteboardEntityRecognizer::UnloadEngine()
+{
+    processor_ = nullptr;
+    if (cleanSSL_ != nullptr) {
+        cleanSSL_();
+        cleanSSL_ = nullptr;
+    }
+    if (sslHandle_ != nullptr) {
+        dlclose(sslHandle_);
+        sslHandle_ = nullptr;
+    }
+    if (nluHandle_ != nullptr) {
+        dlclose(nluHandle_);
+        nluHandle_ = nullptr;
+    }
+}
+
+int32_t PasteboardEntityRecognizer::Process(const std::string &text, std::string &entity)
+{
+    return processor_->Process(text, entity);
+}
+} // namespace OHOS::MiscServices
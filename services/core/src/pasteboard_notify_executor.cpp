@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_notify_executor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
+#include "common/pasteboard_common_utils.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+namespace {
+uint64_t NowMs()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+} // namespace
+
+PasteboardNotifyExecutor::PasteboardNotifyExecutor(size_t workerNum, size_t queueCapacity, uint64_t timeoutMs)
+    : workerNum_(std::max<size_t>(workerNum, 1)), queueCapacity_(std::max<size_t>(queueCapacity, 1)),
+      timeoutMs_(timeoutMs)
+{
+}
+
+PasteboardNotifyExecutor::~PasteboardNotifyExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    cond_.notify_all();
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void PasteboardNotifyExecutor::Post(const sptr<RefBase> &observer, const std::string &coalesceKey,
+    std::function<void()> task)
+{
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(observer != nullptr && task != nullptr, PASTEBOARD_MODULE_SERVICE,
+        "observer or task is null");
+    std::lock_guard<std::mutex> lock(mutex_);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(!stopped_, PASTEBOARD_MODULE_SERVICE, "notify executor stopped");
+    const void *key = observer.GetRefPtr();
+    uint64_t now = NowMs();
+    auto found = queues_.find(key);
+    if (found != queues_.end() && IsTimedOutLocked(found->second, now)) {
+        stats_.dropped++;
+        return;
+    }
+    auto &queue = found != queues_.end() ? found->second : queues_[key];
+    queue.observer = observer;
+    if (!queue.tasks.empty() && queue.tasks.back().coalesceKey == coalesceKey) {
+        stats_.coalesced++;
+        return;
+    }
+    if (queue.tasks.size() >= queueCapacity_) {
+        queue.tasks.pop_front();
+        stats_.dropped++;
+    }
+    queue.tasks.push_back(Task{ coalesceKey, std::move(task), now });
+    if (!queue.running && queue.tasks.size() == 1) {
+        ready_.push_back(key);
+    }
+    StartWorkersLocked();
+    cond_.notify_one();
+}
+
+bool PasteboardNotifyExecutor::IsTimedOutLocked(ObserverQueue &queue, uint64_t now)
+{
+    if (!queue.running || now - queue.startTime <= timeoutMs_) {
+        return false;
+    }
+    if (!queue.timedOut) {
+        queue.timedOut = true;
+        stats_.timeouts++;
+        stats_.dropped += queue.tasks.size();
+        queue.tasks.clear();
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observer callback timeout, cost=%{public}" PRIu64 "ms",
+            now - queue.startTime);
+    }
+    return true;
+}
+
+void PasteboardNotifyExecutor::StartWorkersLocked()
+{
+    while (workers_.size() < workerNum_) {
+        workers_.emplace_back([this] { Work(); });
+        PasteBoardCommonUtils::SetThreadTaskName(workers_.back(), "NotifyObservers");
+    }
+}
+
+void PasteboardNotifyExecutor::Work()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this] { return stopped_ || !ready_.empty(); });
+        if (stopped_) {
+            return;
+        }
+        const void *observer = ready_.front();
+        ready_.pop_front();
+        auto found = queues_.find(observer);
+        if (found == queues_.end() || found->second.tasks.empty()) {
+            continue;
+        }
+        auto &queue = found->second;
+        Task task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queue.running = true;
+        queue.startTime = NowMs();
+        uint64_t latency = queue.startTime - task.postTime;
+        stats_.totalLatencyMs += latency;
+        stats_.maxLatencyMs = std::max(stats_.maxLatencyMs, latency);
+        lock.unlock();
+
+        task.func();
+        task.func = nullptr;
+
+        lock.lock();
+        stats_.dispatched++;
+        // a running queue is only erased here
+        auto &finished = queues_[observer];
+        finished.running = false;
+        finished.timedOut = false;
+        if (finished.tasks.empty()) {
+            queues_.erase(observer);
+        } else {
+            ready_.push_back(observer);
+            cond_.notify_one();
+        }
+    }
+}
+
+PasteboardNotifyExecutor::Stats PasteboardNotifyExecutor::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    for (const auto &[observer, queue] : queues_) {
+        stats.pending += queue.tasks.size();
+    }
+    return stats;
+}
+} // namespace OHOS::MiscServices
@@ -13,9 +13,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <dlfcn.h>
 #include <libxml/HTMLparser.h>
+#include <memory>
 #include <regex>
 
 #include "pasteboard_hilog.h"
@@ -23,27 +26,116 @@
 
 namespace OHOS::MiscServices {
 
-constexpr int32_t MIN_HTTP_URL_LENGTH = 7;
-constexpr int32_t MIN_FLIGHT_NUMBER_LENGTH = 5;
-constexpr int32_t MAX_FLIGHT_NUMBER_LENGTH = 7;
-
-std::map<uint32_t, std::string> PatternDetection::patterns_{
-    { static_cast<uint32_t>(Pattern::URL), std::string("[a-zA-Z0-9+.-]+://[-a-zA-Z0-9+&@#/%?"
-                                                       "=~_|!:,.;]*[-a-zA-Z0-9+&@#/%=~_]") },
-    { static_cast<uint32_t>(Pattern::NUMBER), std::string("[-+]?[0-9]*\\.?[0-9]+") },
-    { static_cast<uint32_t>(Pattern::EMAIL_ADDRESS), std::string("(([a-zA-Z0-9_\\-\\.\\%\\+]+)@"
-                                                                 "(([a-zA-Z0-9\\-]+(?:\\.[a-zA-Z0-9\\-]+)*)|"
-                                                                 "(?:\\[([0-9]{1,3}\\.){3}[0-9]{1,3}\\]))"
-                                                                 "([a-zA-Z]{1,}|[0-9]{1,3}|\\.[a-zA-Z0-9\\-]+))") },
-    { static_cast<uint32_t>(Pattern::HTTP_URL), std::string("(?:^|\\s+)https?://[^\\s]+") },
-    { static_cast<uint32_t>(Pattern::FLIGHT_NUMBER), std::string("\\b([A-Z]{2}|[0-9][A-Z])\\d{3,4}[A-Z]?\\b") },
-};
+namespace {
+constexpr size_t HTML_CHUNK_SIZE = 64 * 1024;
+const std::string HTTP_SCHEME = "http";
+const std::string SCHEME_SEPARATOR = "://";
+const char *WHITESPACE_CHARS = " \t\n\v\f\r";
+
+inline bool IsDigit(char chr)
+{
+    return chr >= '0' && chr <= '9';
+}
+
+inline bool IsUpper(char chr)
+{
+    return chr >= 'A' && chr <= 'Z';
+}
+
+inline bool IsSpace(char chr)
+{
+    return std::isspace(static_cast<unsigned char>(chr)) != 0;
+}
+
+inline bool IsWordChar(char chr)
+{
+    return std::isalnum(static_cast<unsigned char>(chr)) != 0 || chr == '_';
+}
+
+// same as "(?:^|\s+)https?://[^\s]+" starting at pos
+bool MatchHttpUrlAt(const std::string &text, size_t pos)
+{
+    if ((pos != 0 && !IsSpace(text[pos - 1])) || text.compare(pos, HTTP_SCHEME.size(), HTTP_SCHEME) != 0) {
+        return false;
+    }
+    size_t cur = pos + HTTP_SCHEME.size();
+    if (cur < text.size() && text[cur] == 's') {
+        ++cur;
+    }
+    if (text.compare(cur, SCHEME_SEPARATOR.size(), SCHEME_SEPARATOR) != 0) {
+        return false;
+    }
+    cur += SCHEME_SEPARATOR.size();
+    return cur < text.size() && !IsSpace(text[cur]);
+}
+
+// same as "\b([A-Z]{2}|[0-9][A-Z])\d{3,4}[A-Z]?\b" starting at pos
+bool MatchFlightNumberAt(const std::string &text, size_t pos)
+{
+    constexpr size_t prefixLen = 2;
+    constexpr size_t minDigits = 3;
+    constexpr size_t maxDigits = 4;
+    if ((pos != 0 && IsWordChar(text[pos - 1])) || pos + prefixLen > text.size()) {
+        return false;
+    }
+    if (!(IsUpper(text[pos]) || IsDigit(text[pos])) || !IsUpper(text[pos + 1])) {
+        return false;
+    }
+    size_t digits = 0;
+    while (digits < maxDigits && pos + prefixLen + digits < text.size() && IsDigit(text[pos + prefixLen + digits])) {
+        ++digits;
+    }
+    auto isBoundary = [&text](size_t end) {
+        return end == text.size() || !IsWordChar(text[end]);
+    };
+    for (size_t count = minDigits; count <= digits; ++count) {
+        size_t end = pos + prefixLen + count;
+        if (isBoundary(end) || (end < text.size() && IsUpper(text[end]) && isBoundary(end + 1))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void OnHtmlText(void *ctx, const xmlChar *chars, int len)
+{
+    if (ctx != nullptr && chars != nullptr && len > 0) {
+        static_cast<std::string *>(ctx)->append(reinterpret_cast<const char *>(chars), static_cast<size_t>(len));
+    }
+}
+
+bool IsAllDetected(const std::set<Pattern> &patternsOut, const std::set<Pattern> &patternsIn)
+{
+    for (Pattern pattern : patternsIn) {
+        if (pattern < Pattern::COUNT && patternsOut.find(pattern) == patternsOut.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Regexes for the patterns without a hand-rolled scanner, compiled once.
+const std::map<Pattern, std::regex> &GetCompiledRegexes()
+{
+    static const std::map<Pattern, std::regex> regexes = {
+        { Pattern::URL, std::regex("[a-zA-Z0-9+.-]+://[-a-zA-Z0-9+&@#/%?=~_|!:,.;]*[-a-zA-Z0-9+&@#/%=~_]") },
+        { Pattern::EMAIL_ADDRESS, std::regex("(([a-zA-Z0-9_\\-\\.\\%\\+]+)@"
+                                             "(([a-zA-Z0-9\\-]+(?:\\.[a-zA-Z0-9\\-]+)*)|"
+                                             "(?:\\[([0-9]{1,3}\\.){3}[0-9]{1,3}\\]))"
+                                             "([a-zA-Z]{1,}|[0-9]{1,3}|\\.[a-zA-Z0-9\\-]+))") },
+    };
+    return regexes;
+}
+
+// compile on library load, so the first detection after service start does not pay for it
+const auto &g_compiledRegexes = GetCompiledRegexes();
+} // namespace
 
 const std::set<Pattern> PatternDetection::Detect(
     const std::set<Pattern> &patternsToCheck, const PasteData &pasteData, bool hasHTML, bool hasPlain)
 {
     std::set<Pattern> existedPatterns;
-    for (auto &record : pasteData.AllRecords()) {
+    for (auto &record : pasteData.PeekRecords()) {
         if (patternsToCheck == existedPatterns) {
             break;
         }
@@ -52,8 +144,7 @@ const std::set<Pattern> PatternDetection::Detect(
             DetectPlainText(existedPatterns, patternsToCheck, recordText);
         }
         if (hasHTML && record->GetHtmlTextV0() != nullptr) {
-            std::string recordText = ExtractHtmlContent(*(record->GetHtmlTextV0()));
-            DetectPlainText(existedPatterns, patternsToCheck, recordText);
+            DetectHtmlText(existedPatterns, patternsToCheck, *(record->GetHtmlTextV0()));
         }
     }
     return existedPatterns;
@@ -62,62 +153,84 @@ const std::set<Pattern> PatternDetection::Detect(
 void PatternDetection::DetectPlainText(
     std::set<Pattern> &patternsOut, const std::set<Pattern> &patternsIn, const std::string &plainText)
 {
+    std::set<Pattern> pending;
     for (Pattern pattern : patternsIn) {
         if (patternsOut.find(pattern) != patternsOut.end()) {
             continue;
         }
-        uint32_t patternUint32 = static_cast<uint32_t>(pattern);
-        auto it = patterns_.find(patternUint32);
-        if (it == patterns_.end()) {
+        if (pattern >= Pattern::COUNT) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "pasteboard pattern, unexpected Pattern value!");
             continue;
         }
-        std::regex curRegex(it->second);
-        std::smatch match;
+        pending.insert(pattern);
+    }
+    if (pending.empty()) {
+        return;
+    }
 
-        if (!std::regex_search(plainText, match, curRegex)) {
-            continue;
+    // one pass over the text for the scanned patterns and the cheap gates of the regex ones
+    bool needNumber = pending.count(Pattern::NUMBER) != 0;
+    bool needHttpUrl = pending.count(Pattern::HTTP_URL) != 0;
+    bool needFlightNumber = pending.count(Pattern::FLIGHT_NUMBER) != 0;
+    bool hasSchemeSeparator = false;
+    bool hasAt = false;
+    for (size_t pos = 0; pos < plainText.size(); ++pos) {
+        char chr = plainText[pos];
+        if (needNumber && IsDigit(chr)) {
+            patternsOut.insert(Pattern::NUMBER);
+            needNumber = false;
         }
-
-        std::string matched = match.str();
-        bool isValidPattern = false;
-
-        if (pattern == Pattern::HTTP_URL) {
-            isValidPattern = matched.length() >= MIN_HTTP_URL_LENGTH;
-        } else if (pattern == Pattern::FLIGHT_NUMBER) {
-            isValidPattern = (matched.length() >= MIN_FLIGHT_NUMBER_LENGTH &&
-                matched.length() <= MAX_FLIGHT_NUMBER_LENGTH);
-        } else {
-            isValidPattern = true;
+        if (needHttpUrl && chr == 'h' && MatchHttpUrlAt(plainText, pos)) {
+            patternsOut.insert(Pattern::HTTP_URL);
+            needHttpUrl = false;
         }
+        if (needFlightNumber && (IsUpper(chr) || IsDigit(chr)) && MatchFlightNumberAt(plainText, pos)) {
+            patternsOut.insert(Pattern::FLIGHT_NUMBER);
+            needFlightNumber = false;
+        }
+        hasSchemeSeparator = hasSchemeSeparator || (chr == ':' && plainText.compare(pos, SCHEME_SEPARATOR.size(),
+            SCHEME_SEPARATOR) == 0);
+        hasAt = hasAt || chr == '@';
+    }
 
-        if (isValidPattern) {
+    for (const auto &[pattern, regex] : g_compiledRegexes) {
+        if (pending.count(pattern) == 0) {
+            continue;
+        }
+        bool gated = (pattern == Pattern::URL && !hasSchemeSeparator) || (pattern == Pattern::EMAIL_ADDRESS && !hasAt);
+        if (!gated && std::regex_search(plainText, regex)) {
             patternsOut.insert(pattern);
         }
     }
 }
 
-std::string PatternDetection::ExtractHtmlContent(const std::string &html_str)
+void PatternDetection::DetectHtmlText(
+    std::set<Pattern> &patternsOut, const std::set<Pattern> &patternsIn, const std::string &html)
 {
-    xmlDocPtr doc = htmlReadMemory(html_str.c_str(), html_str.size(), nullptr, nullptr, 0);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(doc != nullptr, "", PASTEBOARD_MODULE_SERVICE,
-        "parse html failed, doc is null");
-    xmlNode *rootNode = xmlDocGetRootElement(doc);
-    if (rootNode == nullptr) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "parse html failed, rootNode is null");
-        xmlFreeDoc(doc);
-        return "";
-    }
-    xmlChar *xmlStr = xmlNodeGetContent(rootNode);
-    if (xmlStr == nullptr) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "parse html failed, xmlStr is null");
-        xmlFreeDoc(doc);
-        return "";
-    }
+    // collect text through SAX callbacks only, no DOM is built
+    htmlSAXHandler handler = {};
+    handler.characters = OnHtmlText;
+    handler.cdataBlock = OnHtmlText;
+    std::string text;
+    htmlParserCtxtPtr ctxt = htmlCreatePushParserCtxt(&handler, &text, nullptr, 0, nullptr, XML_CHAR_ENCODING_NONE);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(ctxt != nullptr, PASTEBOARD_MODULE_SERVICE, "create html parser failed");
+    std::unique_ptr<htmlParserCtxt, decltype(&htmlFreeParserCtxt)> ctxtGuard(ctxt, htmlFreeParserCtxt);
 
-    std::string result(reinterpret_cast<const char *>(xmlStr));
-    xmlFree(xmlStr);
-    xmlFreeDoc(doc);
-    return result;
+    for (size_t offset = 0; offset < html.size(); offset += HTML_CHUNK_SIZE) {
+        size_t length = std::min(HTML_CHUNK_SIZE, html.size() - offset);
+        htmlParseChunk(ctxt, html.data() + offset, static_cast<int>(length), 0);
+        // no pattern spans whitespace, so text up to the last whitespace can be matched and dropped
+        size_t cut = text.find_last_of(WHITESPACE_CHARS);
+        if (cut == std::string::npos) {
+            continue;
+        }
+        DetectPlainText(patternsOut, patternsIn, text.substr(0, cut + 1));
+        text.erase(0, cut + 1);
+        if (IsAllDetected(patternsOut, patternsIn)) {
+            return;
+        }
+    }
+    htmlParseChunk(ctxt, nullptr, 0, 1);
+    DetectPlainText(patternsOut, patternsIn, text);
 }
 } // namespace OHOS::MiscServices
\ No newline at end of file
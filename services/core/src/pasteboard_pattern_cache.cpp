@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_pattern_cache.h"
+
+namespace OHOS::MiscServices {
+bool PasteboardPatternCache::Lookup(int32_t userId, uint32_t dataId, bool hasHTML, bool hasPlain,
+    const std::set<Pattern> &patterns, std::set<Pattern> &result)
+{
+    uint32_t mask = ToMask(patterns);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cache = caches_.find(userId);
+    if (cache == caches_.end() || cache->second.dataId != dataId) {
+        stats_.misses++;
+        return false;
+    }
+    auto detected = cache->second.detected.find(ToTextKey(hasHTML, hasPlain));
+    if (detected == cache->second.detected.end() || (detected->second.checked & mask) != mask) {
+        stats_.misses++;
+        return false;
+    }
+    result.clear();
+    for (Pattern pattern : patterns) {
+        if (pattern < Pattern::COUNT && (detected->second.found & (1u << static_cast<uint32_t>(pattern))) != 0) {
+            result.insert(pattern);
+        }
+    }
+    stats_.hits++;
+    return true;
+}
+
+uint64_t PasteboardPatternCache::GetGeneration(int32_t userId) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cache = caches_.find(userId);
+    return cache == caches_.end() ? 0 : cache->second.generation;
+}
+
+void PasteboardPatternCache::Store(int32_t userId, uint32_t dataId, bool hasHTML, bool hasPlain, uint64_t generation,
+    const std::set<Pattern> &patterns, const std::set<Pattern> &result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &cache = caches_[userId];
+    if (generation != cache.generation) {
+        return;
+    }
+    if (cache.dataId != dataId) {
+        cache.dataId = dataId;
+        cache.detected.clear();
+    }
+    auto &detected = cache.detected[ToTextKey(hasHTML, hasPlain)];
+    detected.checked |= ToMask(patterns);
+    detected.found |= ToMask(result);
+}
+
+void PasteboardPatternCache::Invalidate(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the entry stays to keep its generation, only the results go
+    auto &cache = caches_[userId];
+    cache.generation++;
+    cache.dataId = 0;
+    cache.detected.clear();
+}
+
+PasteboardPatternCache::Stats PasteboardPatternCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+uint32_t PasteboardPatternCache::ToMask(const std::set<Pattern> &patterns)
+{
+    uint32_t mask = 0;
+    for (Pattern pattern : patterns) {
+        if (pattern < Pattern::COUNT) {
+            mask |= 1u << static_cast<uint32_t>(pattern);
+        }
+    }
+    return mask;
+}
+
+uint32_t PasteboardPatternCache::ToTextKey(bool hasHTML, bool hasPlain)
+{
+    return (hasHTML ? 1u : 0u) | (hasPlain ? 2u : 0u);
+}
+} // namespace OHOS::MiscServices
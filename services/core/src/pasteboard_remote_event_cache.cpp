@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_remote_event_cache.h"
+
+namespace OHOS::MiscServices {
+bool PasteboardRemoteEventCache::GetEvent(int32_t user, Stage &stage, Event &event) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = events_.find(user);
+    if (it == events_.end()) {
+        return false;
+    }
+    stage = it->second.stage;
+    event = it->second.event;
+    return true;
+}
+
+uint64_t PasteboardRemoteEventCache::GetGeneration() const
+{
+    return generation_.load();
+}
+
+void PasteboardRemoteEventCache::StoreEvent(int32_t user, uint64_t generation, Stage stage, const Event &event)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generation_.load()) {
+        return;
+    }
+    auto &cached = events_[user];
+    cached.stage = stage;
+    cached.event = event;
+}
+
+bool PasteboardRemoteEventCache::GetTypes(const Event &event, RemoteTypes &types) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!IsSameClip(types_, event)) {
+        return false;
+    }
+    types = types_.types;
+    return true;
+}
+
+void PasteboardRemoteEventCache::StoreTypes(uint64_t generation, const Event &event, const RemoteTypes &types)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generation_.load()) {
+        return;
+    }
+    types_.valid = true;
+    types_.deviceId = event.deviceId;
+    types_.seqId = event.seqId;
+    types_.dataId = event.dataId;
+    types_.types = types;
+}
+
+void PasteboardRemoteEventCache::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    events_.clear();
+    types_ = CachedTypes();
+}
+
+void PasteboardRemoteEventCache::Online(const std::string &device)
+{
+    (void)device;
+}
+
+void PasteboardRemoteEventCache::Offline(const std::string &device)
+{
+    (void)device;
+    Invalidate();
+}
+
+void PasteboardRemoteEventCache::OnReady(const std::string &device)
+{
+    (void)device;
+}
+
+bool PasteboardRemoteEventCache::IsSameClip(const CachedTypes &cached, const Event &event)
+{
+    return cached.valid && cached.deviceId == event.deviceId && cached.seqId == event.seqId &&
+        cached.dataId == event.dataId;
+}
+} // namespace OHOS::MiscServices
@@ -14,8 +14,8 @@
  */
 #include "pasteboard_service.h"
 
-#include <dlfcn.h>
 #include <sys/mman.h>
+#include <tuple>
 
 #include "ashmem.h"
 #include "accesstoken_kit.h"
@@ -64,6 +64,7 @@
 #ifdef PB_SCREENLOCK_MGR_ENABLE
 #include "screenlock_manager.h"
 #endif // PB_SCREENLOCK_MGR_ENABLE
+#include "tlv_chunk.h"
 #include "tokenid_kit.h"
 #include "uri_permission_manager_client.h"
 #ifdef SCENE_BOARD_ENABLE
@@ -90,9 +91,6 @@ constexpr int32_t MAX_REMOTE_FILE_MANAGER_URI_COUNT = 256;
 constexpr uint32_t MAX_IPC_THREAD_NUM = 32;
 constexpr const char *PASTEBOARD_SERVICE_SA_NAME = "pasteboard_service";
 constexpr const char *PASTEBOARD_SERVICE_NAME = "PasteboardService";
-constexpr const char *NLU_SO_PATH = "libai_nlu_innerapi.z.so";
-constexpr const char *SSL_SO_PATH = "libcrypto_openssl.z.so";
-constexpr const char *GET_PASTE_DATA_PROCESSOR = "GetPasteDataProcessor";
 constexpr const char *FAIL_TO_GET_TIME_STAMP = "FAIL_TO_GET_TIME_STAMP";
 constexpr const char *SECURE_PASTE_PERMISSION = "ohos.permission.SECURE_PASTE";
 constexpr const char *READ_PASTEBOARD_PERMISSION = "ohos.permission.READ_PASTEBOARD";
@@ -117,11 +115,52 @@ constexpr int32_t DEVICE_COLLABORATION_UID = 5521;
 constexpr uint64_t SYSTEM_APP_MASK = (static_cast<uint64_t>(1) << 32);
 constexpr uint32_t MAX_BUNDLE_NAME_LENGTH = 127;
 constexpr int64_t MIN_ASHMEM_DATA_SIZE = 32 * 1024;
+constexpr size_t MAX_ENCODED_CLIP_VARIANTS = 4;
 constexpr int32_t E_OK_OPERATION = 0;
 constexpr int32_t SET_VALUE_SUCCESS = 1;
 constexpr uid_t ANCO_SERVICE_BROKER_UID = 5557;
 constexpr float RECALCULATE_DATA_SIZE = 0.9;
 constexpr uint16_t MAX_TRANSFER_SIZE = 1300;
+constexpr uint32_t MAX_CHUNK_RETRY = 3;
+constexpr uint32_t CHUNK_RETRY_INTERVAL = 200; // milliseconds, grows with each retry of the same frame
+constexpr uint32_t MAX_CHUNK_RETRY_TIME = 1000; // milliseconds of retry waits per paste, the binder thread is held
+constexpr size_t STATS_LABEL_WIDTH = 12;
+constexpr uint64_t PERCENT = 100;
+
+// Text longer than the limit is never recognized, so stop gathering as soon as it would be exceeded.
+bool AppendRecognitionText(std::string &primaryText, const std::string &text)
+{
+    if (primaryText.size() > MAX_RECOGNITION_LENGTH || text.size() > MAX_RECOGNITION_LENGTH - primaryText.size()) {
+        return false;
+    }
+    primaryText.append(text);
+    return true;
+}
+
+std::string HitRate(uint64_t hits, uint64_t misses)
+{
+    uint64_t total = hits + misses;
+    return total == 0 ? "-" : std::to_string(hits * PERCENT / total) + "%";
+}
+
+std::string AverageMs(uint64_t totalMs, uint64_t count)
+{
+    return std::to_string(count == 0 ? 0 : totalMs / count) + "ms";
+}
+
+// Formats one "|Label :  value" line per pair, padding the labels to a common width.
+std::string FormatStats(const std::vector<std::pair<std::string, std::string>> &lines)
+{
+    size_t width = STATS_LABEL_WIDTH;
+    for (const auto &line : lines) {
+        width = std::max(width, line.first.size());
+    }
+    std::string result;
+    for (const auto &[label, value] : lines) {
+        result.append("|").append(label).append(width - label.size(), ' ').append(":  ").append(value).append("\n");
+    }
+    return result;
+}
 
 const bool G_REGISTER_RESULT = SystemAbility::MakeAndRegisterAbility(new PasteboardService());
 const std::string CONSTRAINT = "constraint.distributed.transmission.outgoing";
@@ -129,7 +168,6 @@ const std::string CONSTRAINT = "constraint.distributed.transmission.outgoing";
 using namespace Security::AccessToken;
 using namespace OHOS::AppFileService::ModuleRemoteFileShare;
 std::mutex PasteboardService::historyMutex_;
-std::shared_mutex PasteboardService::pasteDataMutex_;
 std::vector<std::string> PasteboardService::dataHistory_;
 std::shared_ptr<Command> PasteboardService::copyHistory;
 std::shared_ptr<Command> PasteboardService::copyData;
@@ -145,12 +183,17 @@ PasteboardService::PasteboardService(): SystemAbility(PASTEBOARD_SERVICE_ID, tru
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "PasteboardService Start.");
     PasteboardService::state_ = ServiceRunningState::STATE_NOT_START;
     p2pEstablishInfo_.pasteBlock = nullptr;
+    entityRecognizer_.SetResultCallback([this](const std::string &text, const std::string &entity) {
+        OnRecognizePasteData(text, entity);
+    });
+    entityRecognizer_.SetObserverQuery([this]() { return entityObserverMap_.Size() != 0; });
 }
 
 PasteboardService::~PasteboardService()
 {
     clients_.Clear();
     UnsubscribeAllEntityObserver();
+    entityRecognizer_.Stop();
 }
 
 int32_t PasteboardService::Init()
@@ -212,6 +255,7 @@ void PasteboardService::OnStart()
         (capacity >= MIN_LOCAL_CAPACITY && capacity <= MAX_LOCAL_CAPACITY) ? capacity : DEFAULT_LOCAL_CAPACITY;
     maxLocalCapacity_.store(maxLocalCapacity * SIZE_K * SIZE_K);
     moduleConfig_.Init();
+    DMAdapter::GetInstance().Register(&remoteEventCache_);
     moduleConfig_.Watch(std::bind(&PasteboardService::OnConfigChange, this, std::placeholders::_1));
     ffrtTimer_ = FFRTPool::GetTimer("pasteboard_service");
     UpdateAgedTime();
@@ -260,6 +304,26 @@ void PasteboardService::InitializeDumpCommands()
         });
     PasteboardDumpHelper::GetInstance().RegisterCommand(copyHistory);
     PasteboardDumpHelper::GetInstance().RegisterCommand(copyData);
+    const std::vector<std::tuple<std::string, std::string, std::function<std::string()>>> statsCommands = {
+        { "--lock-stats", "Show paste data lock contention of foreground users.", [this] { return DumpLockStats(); } },
+        { "--set-stats", "Show the SetPasteData queue depth and supersession counts.",
+            [this] { return DumpSetStats(); } },
+        { "--notify-stats", "Show observer notification latency, coalesced and dropped counts.",
+            [this] { return DumpNotifyStats(); } },
+        { "--timer-stats", "Show pending service timers and how late they fired.",
+            [this] { return DumpTimerStats(); } },
+        { "--pattern-stats", "Show pattern detection cache hits and misses.", [this] { return DumpPatternStats(); } },
+        { "--version-stats", "Show remote device version cache hit rate and refreshes.",
+            [this] { return DumpVersionStats(); } },
+    };
+    for (const auto &[option, help, dump] : statsCommands) {
+        auto command = std::make_shared<Command>(std::vector<std::string>{ option }, help,
+            [dump = dump](const std::vector<std::string> &input, std::string &output) -> bool {
+                output = dump();
+                return true;
+            });
+        PasteboardDumpHelper::GetInstance().RegisterCommand(command);
+    }
     CommonEventSubscriber();
     AccountStateSubscriber();
 #ifdef PB_COCKPIT_PLATFORM_ENABLE
@@ -287,6 +351,7 @@ void PasteboardService::OnStop()
         EventFwk::CommonEventManager::UnSubscribeCommonEvent(commonEventSubscriber_);
     }
     moduleConfig_.DeInit();
+    DMAdapter::GetInstance().Unregister(&remoteEventCache_);
     switch_.DeInit();
     EventCenter::GetInstance().Unsubscribe(PasteboardEvent::DISCONNECT);
     EventCenter::GetInstance().Unsubscribe(OHOS::MiscServices::Event::EVT_REMOTE_CHANGE);
@@ -429,17 +494,13 @@ void PasteboardService::SetCriticalTimer()
     PASTEBOARD_CHECK_AND_RETURN_LOGE(ffrtTimer_ != nullptr, PASTEBOARD_MODULE_SERVICE, "ffrtTimer_ is null");
 
     FFRTTask task = [this] {
-        std::thread thread([=]() {
-            if (!HasActivePasteboardWork()) {
-                Memory::MemMgrClient::GetInstance().SetCritical(getpid(), false, PASTEBOARD_SERVICE_ID);
-                isCritical_.store(false);
-            }
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "SetCriticalTime");
-        thread.detach();
+        if (!HasActivePasteboardWork()) {
+            Memory::MemMgrClient::GetInstance().SetCritical(getpid(), false, PASTEBOARD_SERVICE_ID);
+            isCritical_.store(false);
+        }
     };
 
-    ffrtTimer_->SetTimer(SET_CRITICAL_ID, task, static_cast<uint32_t>(agedTime_.load()));
+    ffrtTimer_->SetBlockingTimer(SET_CRITICAL_ID, task, static_cast<uint32_t>(agedTime_.load()));
 
     if (!isCritical_.load()) {
         Memory::MemMgrClient::GetInstance().SetCritical(getpid(), true, PASTEBOARD_SERVICE_ID);
@@ -470,6 +531,7 @@ void PasteboardService::OnRemoveDeviceProfile()
 
 void PasteboardService::HandleWifiOffAndClearDistributedEvent(int32_t userId)
 {
+    remoteEventCache_.Invalidate();
     bool isdeviceCollabSwitch = switch_.GetDeviceCollabSwitch(userId);
     PASTEBOARD_CHECK_AND_RETURN_LOGD(!isdeviceCollabSwitch, PASTEBOARD_MODULE_SERVICE,
         "wifi off but DeviceCollabSwitch is on");
@@ -542,6 +604,7 @@ int32_t PasteboardService::ClearInner(int32_t userId, const AppInfo &appInfo)
     if (hasData) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "ClearInner: found data for userId=%{public}d, erasing", userId);
         clips_.Erase(userId);
+        InvalidateEncodedClip(userId);
         delayDataId_ = 0;
         delayTokenId_ = 0;
     }
@@ -607,14 +670,18 @@ int32_t PasteboardService::GetAllEntryPlainText(uint32_t dataId, uint32_t record
         }
         int32_t result = static_cast<int32_t>(PasteboardError::E_OK);
         if (entry->GetMimeType() == MIMETYPE_TEXT_PLAIN && !entry->HasContentByMimeType(MIMETYPE_TEXT_PLAIN)) {
+            // no budget left for delayed text, do not pull it across IPC
+            if (primaryText.size() == MAX_RECOGNITION_LENGTH) {
+                return static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION);
+            }
             result = GetRecordValueByType(dataId, recordId, *entry);
         }
         if (result != static_cast<int32_t>(PasteboardError::E_OK)) {
             continue;
         }
         std::shared_ptr<std::string> plainTextPtr = entry->ConvertToPlainText();
-        if (plainTextPtr != nullptr) {
-            primaryText += *plainTextPtr;
+        if (plainTextPtr != nullptr && !AppendRecognitionText(primaryText, *plainTextPtr)) {
+            return static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION);
         }
     }
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "GetAllEntryPlainText finished");
@@ -624,16 +691,21 @@ int32_t PasteboardService::GetAllEntryPlainText(uint32_t dataId, uint32_t record
 std::string PasteboardService::GetAllPrimaryText(const PasteData &pasteData)
 {
     std::string primaryText = "";
-    std::vector<std::shared_ptr<PasteDataRecord>> records = pasteData.AllRecords();
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "size of records=%{public}zu", records.size());
-    for (const auto &record : records) {
-        if (primaryText.size() > MAX_RECOGNITION_LENGTH) {
-            primaryText = "";
-            break;
+    primaryText.reserve(MAX_RECOGNITION_LENGTH);
+    size_t recordCount = pasteData.GetRecordCount();
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "size of records=%{public}zu", recordCount);
+    for (size_t i = 0; i < recordCount; ++i) {
+        auto record = pasteData.PeekRecordAt(i);
+        if (record == nullptr) {
+            continue;
         }
         std::shared_ptr<std::string> plainTextPtr = record->GetPlainTextV0();
         if (plainTextPtr != nullptr) {
-            primaryText += *plainTextPtr;
+            if (!AppendRecognitionText(primaryText, *plainTextPtr)) {
+                PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "primaryText exceeded size");
+                primaryText = "";
+                break;
+            }
             PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "primaryText in record");
             continue;
         }
@@ -680,36 +752,10 @@ int32_t PasteboardService::ExtractEntity(const std::string &entity, std::string
     return static_cast<int32_t>(PasteboardError::NO_DATA_ERROR);
 }
 
-void PasteboardService::OnRecognizePasteData(const std::string &primaryText)
-{
-    PasteBoardCommonUtils::SetTaskName("PasteDataRecognize");
-    std::lock_guard lock(entityRecognizeMutex_);
-    auto nulHandle = dlopen(NLU_SO_PATH, RTLD_NOW);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(nulHandle != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get AIEngine handle");
-    std::unique_ptr<void, decltype(&dlclose)> nulGuard(nulHandle, dlclose);
-
-    auto sslHandle = dlopen(SSL_SO_PATH, RTLD_NOW);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(sslHandle != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get SSL handle");
-    std::unique_ptr<void, decltype(&dlclose)> sslGuard(sslHandle, dlclose);
-
-    auto cleanSSL = reinterpret_cast<GetProcessorFunc>(dlsym(sslHandle, "OPENSSL_cleanup"));
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(cleanSSL != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get cleanSSL");
-
-    OnRecognizePasteDataInner(primaryText, nulHandle);
-    cleanSSL();
-}
-
-void PasteboardService::OnRecognizePasteDataInner(const std::string &primaryText, void *nulHandle)
+void PasteboardService::OnRecognizePasteData(const std::string &primaryText, const std::string &entity)
 {
-    GetProcessorFunc GetProcessor = reinterpret_cast<GetProcessorFunc>(dlsym(nulHandle, GET_PASTE_DATA_PROCESSOR));
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(GetProcessor != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get ProcessorFunc");
-
-    IPasteDataProcessor &processor = GetProcessor();
-    std::string entity = "";
-    int32_t result = processor.Process(primaryText, entity);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(
-        result == ERR_OK, PASTEBOARD_MODULE_SERVICE, "AI Process failed, result=%{public}d", result);
-
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(PasteboardService::state_ == ServiceRunningState::STATE_RUNNING,
+        PASTEBOARD_MODULE_SERVICE, "PasteboardService is not running.");
     std::string location = "";
     int32_t ret = ExtractEntity(entity, location);
     PASTEBOARD_CHECK_AND_RETURN_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK),
@@ -728,16 +774,7 @@ void PasteboardService::RecognizePasteData(PasteData &pasteData)
     if (primaryText.empty()) {
         return;
     }
-    FFRTTask task = [this, primaryText]() {
-        std::thread thread([=]() {
-            PASTEBOARD_CHECK_AND_RETURN_LOGE(PasteboardService::state_ == ServiceRunningState::STATE_RUNNING,
-                PASTEBOARD_MODULE_SERVICE, "PasteboardService is not running.");
-            OnRecognizePasteData(primaryText);
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "RecognizePaste");
-        thread.detach();
-    };
-    FFRTUtils::SubmitTask(task);
+    entityRecognizer_.Submit(primaryText);
 }
 
 int32_t PasteboardService::SubscribeEntityObserver(
@@ -817,12 +854,14 @@ int32_t PasteboardService::UnsubscribeEntityObserver(
             }
             return true;
         });
+    entityRecognizer_.NotifyObserverChanged();
     return ERR_OK;
 }
 
 void PasteboardService::UnsubscribeAllEntityObserver()
 {
     entityObserverMap_.Clear();
+    entityRecognizer_.NotifyObserverChanged();
 }
 
 int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t recordId, int64_t &rawDataSize,
@@ -848,8 +887,7 @@ int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t record
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr,
             static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
             PASTEBOARD_MODULE_SERVICE, "Failed to get raw data, size=%{public}" PRId64, rawDataSize);
-        std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-        ret = entryValue.Decode(pasteDataTlv);
+        ret = entryValue.Decode(rawData, static_cast<size_t>(rawDataSize));
         ::munmap(ptr, rawDataSize);
     } else {
         ret = entryValue.Decode(buffer);
@@ -915,7 +953,7 @@ int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t record
         static_cast<int32_t>(PasteboardError::INVALID_DATA_ID), PASTEBOARD_MODULE_SERVICE,
         "dataId=%{public}u mismatch, local=%{public}u", dataId, data->GetDataId());
 
-    auto record = data->GetRecordById(recordId);
+    auto record = data->PeekRecordById(recordId);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(record != nullptr, static_cast<int32_t>(PasteboardError::INVALID_RECORD_ID),
         PASTEBOARD_MODULE_SERVICE, "recordId=%{public}u invalid, max=%{public}zu", recordId, data->GetRecordCount());
 
@@ -947,7 +985,7 @@ int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t record
             PASTEBOARD_MODULE_SERVICE, "uri invalid");
         std::map<uint32_t, std::vector<Uri>> grantUris = CheckUriPermission(
             *data, std::make_pair(appInfo.bundleName, appInfo.appIndex));
-    return GrantUriPermission(grantUris, appInfo.tokenId, isRemoteData);
+    return GrantUriPermission(grantUris, appInfo.tokenId, isRemoteData, dataId);
     }
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
@@ -958,13 +996,15 @@ int32_t PasteboardService::ProcessDelayHtmlEntry(PasteData &data, const AppInfo
     const auto &targetBundle = targetAppInfo.bundleName;
     const auto &appIndex = targetAppInfo.appIndex;
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(targetAppInfo.userId);
         std::string bundleIndex = PasteBoardCommon::GetDirByAuthority(data.GetOriginAuthority());
         if (!PasteboardWebController::GetInstance().SplitWebviewPasteData(data, bundleIndex, targetAppInfo.userId)) {
             return static_cast<int32_t>(PasteboardError::E_OK);
         }
         PasteboardWebController::GetInstance().SetWebviewPasteData(data, bundleIndex);
         PasteboardWebController::GetInstance().CheckAppUriPermission(data);
+        // data is the stored clip here, and splitting added records to it
+        InvalidateEncodedClip(targetAppInfo.userId);
     }
 
     PasteData tmp;
@@ -984,7 +1024,7 @@ int32_t PasteboardService::ProcessDelayHtmlEntry(PasteData &data, const AppInfo
     PasteboardWebController::GetInstance().CheckAppUriPermission(tmp);
 
     std::map<uint32_t, std::vector<Uri>> grantUris = CheckUriPermission(tmp, std::make_pair(targetBundle, appIndex));
-    int32_t ret = GrantUriPermission(grantUris, targetAppInfo.tokenId, isRemoteData);
+    int32_t ret = GrantUriPermission(grantUris, targetAppInfo.tokenId, isRemoteData, data.GetDataId());
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
         PASTEBOARD_MODULE_SERVICE, "grant to %{public}s:%{public}d failed, ret=%{public}d", targetBundle.c_str(),
         appIndex, ret);
@@ -1228,8 +1268,19 @@ int32_t PasteboardService::ShowProgress(const std::string &progressKey, const sp
 
 bool PasteboardService::WriteRawData(const void *data, int64_t size, int &serFd)
 {
-    MessageParcelWarp messageData;
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr, false, PASTEBOARD_MODULE_SERVICE, "data is null");
+    return WriteRawData({ { data, size } }, serFd);
+}
+
+bool PasteboardService::WriteRawData(const std::vector<std::pair<const void *, int64_t>> &segments, int &serFd)
+{
+    MessageParcelWarp messageData;
+    int64_t size = 0;
+    for (const auto &[data, len] : segments) {
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr && len > 0, false, PASTEBOARD_MODULE_SERVICE,
+            "segment invalid, len:%{public}" PRId64, len);
+        size += len;
+    }
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < size && size <= messageData.GetRawDataSize(), false,
         PASTEBOARD_MODULE_SERVICE, "size invalid, size:%{public}" PRId64, size);
 
@@ -1249,11 +1300,16 @@ bool PasteboardService::WriteRawData(const void *data, int64_t size, int &serFd)
         fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
         return false;
     }
-    if (!messageData.MemcpyData(ptr, static_cast<size_t>(size), data, size)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "memcpy_s failed, fd:%{public}d", fd);
-        ::munmap(ptr, size);
-        fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
-        return false;
+    int64_t offset = 0;
+    for (const auto &[data, len] : segments) {
+        if (!messageData.MemcpyData(reinterpret_cast<uint8_t *>(ptr) + offset, static_cast<size_t>(size - offset),
+            data, len)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "memcpy_s failed, fd:%{public}d", fd);
+            ::munmap(ptr, size);
+            fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
+            return false;
+        }
+        offset += len;
     }
     ::munmap(ptr, size);
     serFd = fd;
@@ -1392,24 +1448,39 @@ int32_t PasteboardService::GetPasteDataInner(int &fd, int64_t &size, std::vector
 int32_t PasteboardService::DealData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data)
 {
     std::vector<uint8_t> pasteDataTlv(0);
+    std::shared_ptr<const std::vector<uint8_t>> recordsTlv = nullptr;
     {
-        std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
-        if (!data.Encode(pasteDataTlv)) {
+        auto read = PasteboardUserLock::Read(data.GetUserId());
+        recordsTlv = GetEncodedRecords(data);
+        bool ret = recordsTlv != nullptr ? data.EncodeWithoutRecords(pasteDataTlv) : data.Encode(pasteDataTlv);
+        if (!ret) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to encode pastedata in TLV");
             HiViewAdapter::ReportUseBehaviour(data, HiViewAdapter::PASTE_STATE, ERR_INVALID_VALUE);
             return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
         }
     }
     int64_t tlvSize = static_cast<int64_t>(pasteDataTlv.size());
+    if (recordsTlv != nullptr) {
+        tlvSize += static_cast<int64_t>(recordsTlv->size());
+    }
     int serviceFd = -1;
     if (tlvSize > MIN_ASHMEM_DATA_SIZE) {
-        bool res = WriteRawData(pasteDataTlv.data(), tlvSize, serviceFd);
+        bool res = false;
+        if (recordsTlv != nullptr) {
+            res = WriteRawData({ { pasteDataTlv.data(), static_cast<int64_t>(pasteDataTlv.size()) },
+                { recordsTlv->data(), static_cast<int64_t>(recordsTlv->size()) } }, serviceFd);
+        } else {
+            res = WriteRawData(pasteDataTlv.data(), tlvSize, serviceFd);
+        }
         if (!res) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to WriteRawData:%{public}" PRId64, tlvSize);
             return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
         }
         pasteDataTlv.clear();
     } else {
+        if (recordsTlv != nullptr) {
+            pasteDataTlv.insert(pasteDataTlv.end(), recordsTlv->begin(), recordsTlv->end());
+        }
         serviceFd = AshmemCreate("DealData Ashmem", 1);
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(serviceFd >= 0,
             static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
@@ -1424,6 +1495,70 @@ int32_t PasteboardService::DealData(int &fd, int64_t &size, std::vector<uint8_t>
     return ERR_OK;
 }
 
+std::shared_ptr<const std::vector<uint8_t>> PasteboardService::GetEncodedRecords(const PasteData &data)
+{
+    if (data.IsRemote() || data.IsDelayData() || data.IsDelayRecord()) {
+        return nullptr;
+    }
+    int32_t userId = data.GetUserId();
+    auto [hasClip, clip] = clips_.Find(userId);
+    if (!hasClip || clip == nullptr || clip->IsRemote() || clip->IsDelayData() || clip->IsDelayRecord() ||
+        clip->GetDataId() != data.GetDataId()) {
+        return nullptr;
+    }
+    // convert uris are the only record fields rewritten per paste, see CheckUriPermission
+    std::vector<std::string> convertUris;
+    for (const auto &record : data.PeekRecords()) {
+        convertUris.emplace_back(record == nullptr ? "" : record->GetConvertUri());
+    }
+    uint64_t epoch = 0;
+    std::shared_ptr<const std::vector<uint8_t>> cached;
+    encodedClips_.ComputeIfPresent(userId, [&](auto, EncodedClips &encoded) {
+        epoch = encoded.epoch;
+        auto it = std::find_if(encoded.variants.begin(), encoded.variants.end(), [&](const EncodedClip &variant) {
+            return variant.source.lock() == clip && variant.dataId == data.GetDataId() &&
+                variant.convertUris == convertUris;
+        });
+        if (it != encoded.variants.end()) {
+            cached = it->records;
+            encoded.variants.splice(encoded.variants.begin(), encoded.variants, it);
+        }
+        return true;
+    });
+    if (cached != nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "reuse encoded records, dataId=%{public}u", data.GetDataId());
+        return cached;
+    }
+    auto records = std::make_shared<std::vector<uint8_t>>();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data.EncodeRecords(*records), nullptr, PASTEBOARD_MODULE_SERVICE,
+        "encode records failed, dataId=%{public}u", data.GetDataId());
+    if (static_cast<int64_t>(records->size()) > MIN_ASHMEM_DATA_SIZE) {
+        encodedClips_.Compute(userId, [&](auto, EncodedClips &encoded) {
+            // the clip changed while encoding, the records may already be stale
+            if (encoded.epoch != epoch) {
+                return true;
+            }
+            encoded.variants.push_front({ clip, data.GetDataId(), std::move(convertUris), records });
+            if (encoded.variants.size() > MAX_ENCODED_CLIP_VARIANTS) {
+                encoded.variants.pop_back();
+            }
+            return true;
+        });
+    }
+    return records;
+}
+
+void PasteboardService::InvalidateEncodedClip(int32_t userId)
+{
+    encodedClips_.Compute(userId, [](auto, EncodedClips &encoded) {
+        encoded.epoch++;
+        encoded.variants.clear();
+        return true;
+    });
+    // every change of the stored clip passes here, so cached pattern results go with the encoded clip
+    patternCache_.Invalidate(userId);
+}
+
 void PasteboardService::AddPermissionRecord(uint32_t tokenId, bool isReadGrant, bool isSecureGrant)
 {
     if (AccessTokenKit::GetTokenTypeFlag(tokenId) != TOKEN_HAP) {
@@ -1470,7 +1605,7 @@ int32_t PasteboardService::CheckAndGrantRemoteUri(PasteData &data, const AppInfo
         }
     }
     ClearP2PEstablishTaskInfo();
-    return GrantUriPermission(grantUris, appInfo.tokenId, isRemoteData);
+    return GrantUriPermission(grantUris, appInfo.tokenId, isRemoteData, data.GetDataId());
 }
 
 bool PasteboardService::RemoteDataTaskManager::IsRemoteDataPasting(const Event &event)
@@ -1688,7 +1823,9 @@ int32_t PasteboardService::GetRemotePasteData(int32_t userId, const Event &event
         if (result.first != nullptr) {
             result.first->SetRemote(true);
             if (distEvt == event) {
+                result.first->BuildTypeIndex();
                 clips_.InsertOrAssign(userId, result.first);
+                InvalidateEncodedClip(userId);
                 IncreaseChangeCount(userId);
                 auto curTime =
                     static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
@@ -1733,17 +1870,22 @@ int32_t PasteboardService::GetLocalData(const AppInfo &appInfo, PasteData &data)
     bool isDelayRecord = false;
     std::string originBundleName;
     {
-        std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+        auto read = PasteboardUserLock::Read(appInfo.userId);
         auto ret = IsDataValid(*(it.second), appInfo.tokenId, appInfo.userId);
         if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "paste data is invalid. ret = %{public}d "
                 "appInfo.userId = %{public}d", ret, appInfo.userId);
             return ret;
         }
-        data = *(it.second);
         originBundleName = it.second->GetBundleName();
         isDelayData = it.second->IsDelayData();
         isDelayRecord = it.second->IsDelayRecord();
+        if (isDelayData || isDelayRecord || it.second->IsRemote()) {
+            data = *(it.second);
+        } else {
+            // Records stay shared with the stored clip until this paste changes one of them.
+            data.ShareFrom(*(it.second));
+        }
     }
     if (isDelayData) {
         GetDelayPasteData(appInfo.userId, data);
@@ -1773,17 +1915,26 @@ void PasteboardService::UpdateClipOnRead(int32_t userId, const PasteData &data,
     }
     bool isNotify = false;
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
-        clips_.ComputeIfPresent(userId, [&data, &isNotify](auto &key, auto &value) {
+        auto write = PasteboardUserLock::Write(userId);
+        bool isUpdated = false;
+        clips_.ComputeIfPresent(userId, [&data, &isNotify, &isUpdated](auto &key, auto &value) {
             if (value->IsDelayData()) {
                 value = std::make_shared<PasteData>(data);
                 isNotify = true;
+                isUpdated = true;
             }
             if (value->IsDelayRecord()) {
                 value = std::make_shared<PasteData>(data);
+                isUpdated = true;
+            }
+            if (isUpdated) {
+                value->BuildTypeIndex();
             }
             return true;
         });
+        if (isUpdated) {
+            InvalidateEncodedClip(userId);
+        }
     }
     if (isNotify) {
         NotifyObservers(originBundleName, userId, PasteboardEventStatus::PASTEBOARD_WRITE);
@@ -1827,7 +1978,7 @@ int32_t PasteboardService::GetDelayPasteRecord(int32_t userId, PasteData &data)
         PASTEBOARD_MODULE_SERVICE, "no delay entry");
     DelayManager::GetLocalEntryValue(delayEntryInfos, getter.first, data);
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(userId);
         std::string bundleIndex = PasteBoardCommon::GetDirByAuthority(data.GetOriginAuthority());
         PasteboardWebController::GetInstance().SplitWebviewPasteData(data, bundleIndex, userId);
         PasteboardWebController::GetInstance().SetWebviewPasteData(data, bundleIndex);
@@ -1899,13 +2050,9 @@ void PasteboardService::EstablishP2PLink(const std::string &networkId, const std
     }
     if (ffrtTimer_) {
         FFRTTask task = [this, networkId, pasteId] {
-            std::thread thread([=]() {
-                PasteComplete(networkId, pasteId);
-            });
-            PasteBoardCommonUtils::SetThreadTaskName(thread, "PasteComplete01");
-            thread.detach();
+            PasteComplete(networkId, pasteId);
         };
-        ffrtTimer_->SetTimer(pasteId, task, MIN_TRANMISSION_TIME);
+        ffrtTimer_->SetBlockingTimer(pasteId, task, MIN_TRANMISSION_TIME);
     }
     OpenP2PLink(networkId);
 #endif
@@ -1927,13 +2074,9 @@ std::shared_ptr<BlockObject<int32_t>> PasteboardService::CheckAndReuseP2PLink(
     });
     if (ffrtTimer_) {
         FFRTTask task = [this, networkId, pasteId] {
-            std::thread thread([=]() {
-                PasteComplete(networkId, pasteId);
-            });
-            PasteBoardCommonUtils::SetThreadTaskName(thread, "PasteComplete02");
-            thread.detach();
+            PasteComplete(networkId, pasteId);
         };
-        ffrtTimer_->SetTimer(pasteId, task, MIN_TRANMISSION_TIME);
+        ffrtTimer_->SetBlockingTimer(pasteId, task, MIN_TRANMISSION_TIME);
     }
     auto p2pNetwork = p2pMap_.Find(networkId);
     bool isP2pSuccess = p2pNetwork.first && p2pNetwork.second.Find(P2P_PRESYNC_ID).first &&
@@ -2164,10 +2307,9 @@ int32_t PasteboardService::CheckRemoteFileDocsUriLimit(const std::vector<Uri> &g
 }
 
 int32_t PasteboardService::GrantPermission(const std::vector<Uri> &grantUris, uint32_t permFlag, bool isRemoteData,
-    uint32_t targetTokenId)
+    uint32_t targetTokenId, uint32_t dataId)
 {
     size_t offset = 0;
-    size_t length = grantUris.size();
     size_t count = PasteData::URI_BATCH_SIZE;
     bool hasGranted = false;
     int32_t permissionCode = 0;
@@ -2180,11 +2322,19 @@ int32_t PasteboardService::GrantPermission(const std::vector<Uri> &grantUris, ui
         static_cast<int32_t>(PasteboardError::E_OK)) {
         return ret;
     }
+    // grants are tied to the target process, which is only known when it is the caller
+    bool useLedger = dataId != 0 && IPCSkeleton::GetCallingTokenID() == targetTokenId;
+    PasteboardUriGrantLedger::Target target{ targetTokenId, IPCSkeleton::GetCallingPid(), permFlag, isRemoteData };
+    std::vector<Uri> pendingUris = useLedger ? uriGrantLedger_.FilterGranted(userId, dataId, target, grantUris) :
+        grantUris;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(!pendingUris.empty(), ret, PASTEBOARD_MODULE_SERVICE,
+        "uris granted already, count=%{public}zu", grantUris.size());
+    size_t length = pendingUris.size();
     while (length > offset) {
         if (length - offset < PasteData::URI_BATCH_SIZE) {
             count = length - offset;
         }
-        auto sendValues = std::vector<Uri>(grantUris.begin() + offset, grantUris.begin() + offset + count);
+        auto sendValues = std::vector<Uri>(pendingUris.begin() + offset, pendingUris.begin() + offset + count);
         if (isRemoteData) {
             permissionCode = AAFwk::UriPermissionManagerClient::GetInstance().GrantUriPermissionPrivileged(
                 sendValues, permFlag, appInfo.bundleName, appInfo.appIndex);
@@ -2198,6 +2348,9 @@ int32_t PasteboardService::GrantPermission(const std::vector<Uri> &grantUris, ui
         }
         hasGranted = hasGranted || (permissionCode == 0);
         ret = permissionCode == 0 ? ret : permissionCode;
+        if (useLedger && permissionCode == 0) {
+            uriGrantLedger_.Record(userId, dataId, target, sendValues);
+        }
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "permissionCode is %{public}d", permissionCode);
         offset += count;
     }
@@ -2211,7 +2364,7 @@ int32_t PasteboardService::GrantPermission(const std::vector<Uri> &grantUris, ui
 }
 
 int32_t PasteboardService::GrantUriPermission(std::map<uint32_t, std::vector<Uri>> &grantUris,
-    uint32_t targetTokenId, bool isRemoteData)
+    uint32_t targetTokenId, bool isRemoteData, uint32_t dataId)
 {
     std::vector<Uri> readUris = grantUris[PasteDataRecord::READ_PERMISSION];
     std::vector<Uri> writeUris = grantUris[PasteDataRecord::READ_WRITE_PERMISSION];
@@ -2230,12 +2383,12 @@ int32_t PasteboardService::GrantUriPermission(std::map<uint32_t, std::vector<Uri
         RemoveInvalidRemoteUri(writeUris);
     }
     auto permFlag = PasteDataRecord::READ_PERMISSION;
-    ret = GrantPermission(readUris, permFlag, isRemoteData, targetTokenId);
+    ret = GrantPermission(readUris, permFlag, isRemoteData, targetTokenId, dataId);
     if (!isRemoteData) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "NeedPersistance, permFlag is %{public}d", permFlag);
         permFlag = PasteDataRecord::READ_WRITE_PERMISSION;
     }
-    auto result = GrantPermission(writeUris, permFlag, isRemoteData, targetTokenId);
+    auto result = GrantPermission(writeUris, permFlag, isRemoteData, targetTokenId, dataId);
     ret = result == 0 ? ret : result;
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "leave, ret=%{public}d", ret);
     return static_cast<int32_t>(PasteboardError::E_OK);
@@ -2248,9 +2401,9 @@ std::map<uint32_t, std::vector<Uri>> PasteboardService::CheckUriPermission(Paste
     std::vector<Uri> readUris;
     std::vector<Uri> writeUris;
     std::map<uint32_t, std::vector<Uri>> result;
-    std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+    auto read = PasteboardUserLock::Read(data.GetUserId());
     for (size_t i = 0; i < data.GetRecordCount(); i++) {
-        auto item = data.GetRecordAt(i);
+        auto item = data.PeekRecordAt(i);
         if (item == nullptr || (!data.IsRemote() && targetBundleAndIndex == data.GetOriginAuthority())) {
             PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "local dev & local app");
             continue;
@@ -2258,6 +2411,11 @@ std::map<uint32_t, std::vector<Uri>> PasteboardService::CheckUriPermission(Paste
         std::shared_ptr<OHOS::Uri> uri = nullptr;
         if (!item->isConvertUriFromRemote && !item->GetConvertUri().empty()) {
             PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "clear local disUri");
+            item.reset();
+            item = data.MutableRecordAt(i);
+            if (item == nullptr) {
+                continue;
+            }
             item->SetConvertUri("");
         }
         if (item->isConvertUriFromRemote && !item->GetConvertUri().empty()) {
@@ -2338,7 +2496,7 @@ bool PasteboardService::HasPasteData()
 
 bool PasteboardService::HasRemoteUri(std::shared_ptr<PasteData> data)
 {
-    for (const auto &record : data->AllRecords()) {
+    for (const auto &record : data->PeekRecords()) {
         if (record == nullptr) {
             continue;
         }
@@ -2421,6 +2579,13 @@ int32_t PasteboardService::GetDataTokenId(PasteData &pasteData)
 
 int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
     const sptr<IPasteboardDelayGetter> delayGetter, const sptr<IPasteboardEntryGetter> entryGetter)
+{
+    bool superseded = false;
+    return SaveData(pasteData, dataSize, delayGetter, entryGetter, superseded);
+}
+
+int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
+    const sptr<IPasteboardDelayGetter> delayGetter, const sptr<IPasteboardEntryGetter> entryGetter, bool &superseded)
 {
     PasteboardTrace tracer("PasteboardService, SetPasteData");
     auto tokenId = pasteData.GetTokenId();
@@ -2428,17 +2593,20 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
         RADAR_REPORT(DFX_SET_PASTEBOARD, DFX_CHECK_SET_AUTHORITY, DFX_SUCCESS);
         return static_cast<int32_t>(PasteboardError::PROHIBIT_COPY);
     }
-    if (setting_.exchange(true)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "is setting.");
-        return static_cast<int32_t>(PasteboardError::TASK_PROCESSING);
-    }
-    CalculateTimeConsuming::SetBeginTime();
     auto appInfo = GetAppInfo(tokenId);
     if (appInfo.userId == ERROR_USERID) {
-        setting_.store(false);
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "userId invalid.");
         return static_cast<int32_t>(PasteboardError::INVALID_USERID_ERROR);
     }
+    return setPipeline_.Submit(appInfo.userId, [&]() {
+        return SaveDataInner(pasteData, dataSize, appInfo, delayGetter, entryGetter);
+    }, superseded);
+}
+
+int32_t PasteboardService::SaveDataInner(PasteData &pasteData, int64_t dataSize, const AppInfo &appInfo,
+    const sptr<IPasteboardDelayGetter> delayGetter, const sptr<IPasteboardEntryGetter> entryGetter)
+{
+    CalculateTimeConsuming::SetBeginTime();
     pasteData.userId_ = appInfo.userId;
     pasteData.deviceId_ = DMAdapter::GetInstance().GetLocalNetworkId();
     SetPasteDataInfo(pasteData, appInfo);
@@ -2451,7 +2619,6 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
     if (hasSplited || dataSize > static_cast<int64_t>(maxLocalCapacity_.load() * RECALCULATE_DATA_SIZE)) {
         int64_t newDataSize = static_cast<int64_t>(pasteData.Count());
         if (newDataSize > maxLocalCapacity_.load()) {
-            setting_.store(false);
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "invalid data size, dataSize=%{public}" PRId64, newDataSize);
             return static_cast<int32_t>(PasteboardError::INVALID_DATA_SIZE);
         }
@@ -2459,7 +2626,15 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
     }
     setPasteDataUId_.store(IPCSkeleton::GetCallingUid());
     RemovePasteData(appInfo);
-    clips_.InsertOrAssign(appInfo.userId, std::make_shared<PasteData>(pasteData));
+    pasteData.BuildTypeIndex();
+    auto clip = std::make_shared<PasteData>();
+    if (pasteData.IsDelayData() || pasteData.IsDelayRecord()) {
+        *clip = pasteData;
+    } else {
+        clip->ShareFrom(pasteData);
+    }
+    clips_.InsertOrAssign(appInfo.userId, clip);
+    InvalidateEncodedClip(appInfo.userId);
     IncreaseChangeCount(appInfo.userId);
     RadarReportInfo radarReportInfo;
     radarReportInfo.stageRes = static_cast<int32_t>(pasteData.IsDelayData());
@@ -2476,7 +2651,6 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
         NotifyObservers(appInfo.bundleName, appInfo.userId, PasteboardEventStatus::PASTEBOARD_WRITE);
     }
     SetPasteDataDot(pasteData, appInfo.userId);
-    setting_.store(false);
     SubscribeKeyboardEvent();
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
@@ -2486,6 +2660,7 @@ void PasteboardService::ClearAgedData(int32_t userId)
     auto data = clips_.Find(userId);
     if (data.first) {
         clips_.Erase(userId);
+        InvalidateEncodedClip(userId);
         delayDataId_ = 0;
         delayTokenId_ = 0;
     }
@@ -2503,15 +2678,11 @@ void PasteboardService::SetDataExpirationTimer(int32_t userId)
     }
 
     FFRTTask task = [this, userId]() {
-        std::thread thread([=]() {
-            ClearAgedData(userId);
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "ClearAgedData");
-        thread.detach();
+        ClearAgedData(userId);
     };
 
     std::string taskName = "data_expiration[userId=" + std::to_string(userId) + "]";
-    ffrtTimer_->SetTimer(taskName, task, static_cast<uint32_t>(agedTime_.load()));
+    ffrtTimer_->SetBlockingTimer(taskName, task, static_cast<uint32_t>(agedTime_.load()));
 }
 
 void PasteboardService::SetPasteDataInfo(PasteData &pasteData, const AppInfo &appInfo)
@@ -2570,12 +2741,9 @@ int32_t PasteboardService::GetMimeTypes(std::vector<std::string> &funcResult)
             if (distEvt.version != ClipPlugin::InfoType::DEFAULT) {
                 return GetRemoteMimeTypes(funcResult, distEvt);
             }
-            PasteData data;
-            int32_t syncTime = 0;
-            int32_t ret = GetRemoteData(userId, distEvt, data, syncTime);
-            PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK),
-                static_cast<int32_t>(PasteboardError::GET_REMOTE_DATA_ERROR),
-                PASTEBOARD_MODULE_SERVICE, "get remote data failed, ret=%{public}d", ret);
+            // dataType is PasteData::GetMimeTypes of the remote clip, no need to pull the payload
+            funcResult = distEvt.dataType;
+            return ERR_OK;
         }
     }
     funcResult = GetLocalMimeTypes();
@@ -2607,7 +2775,7 @@ int32_t PasteboardService::GetPasteDataInfo(PasteDataInfo &pasteDataInfo)
     int32_t textSize = 0;
     int32_t htmlSize = 0;
     for (size_t i = 0; i < pasteData.GetRecordCount(); ++i) {
-        auto record = pasteData.GetRecordAt(i);
+        auto record = pasteData.PeekRecordAt(i);
         if (record == nullptr) {
             continue;
         }
@@ -2652,11 +2820,8 @@ bool PasteboardService::HasDataType(const std::string &mimeType)
             if (distEvt.version != ClipPlugin::InfoType::DEFAULT) {
                 return HasRemoteDataType(mimeType, distEvt);
             }
-            PasteData data;
-            int32_t syncTime = 0;
-            if (GetRemoteData(userId, distEvt, data, syncTime) != static_cast<int32_t>(PasteboardError::E_OK)) {
-                return false;
-            }
+            // dataType already holds every listed type of the remote clip
+            return false;
         }
     }
     return HasLocalDataType(mimeType, tokenId, userId);
@@ -2679,6 +2844,10 @@ bool PasteboardService::HasUtdType(const std::string &utdType)
     if (screenStatus == ScreenEvent::ScreenUnlocked) {
         auto [distRet, distEvt] = GetValidDistributeEvent(userId);
         if (distRet == static_cast<int32_t>(PasteboardError::E_OK)) {
+            bool hasType = false;
+            if (HasRemoteUtdType(utdType, distEvt, hasType)) {
+                return hasType;
+            }
             int32_t syncTime = 0;
             if (GetRemoteData(userId, distEvt, data, syncTime) != static_cast<int32_t>(PasteboardError::E_OK)) {
                 return false;
@@ -2736,7 +2905,14 @@ int32_t PasteboardService::DetectPatterns(const std::vector<Pattern> &patternsTo
     std::shared_ptr<PasteData> pasteData = it.second;
     const std::set<Pattern> patterns(patternsToCheck.begin(), patternsToCheck.end());
     std::set<Pattern> result = {};
+    uint32_t dataId = pasteData->GetDataId();
+    if (patternCache_.Lookup(userId, dataId, hasHTML, hasPlain, patterns, result)) {
+        funcResult.assign(result.begin(), result.end());
+        return ERR_OK;
+    }
+    uint64_t generation = patternCache_.GetGeneration(userId);
     result = OHOS::MiscServices::PatternDetection::Detect(patterns, *pasteData, hasHTML, hasPlain);
+    patternCache_.Store(userId, dataId, hasHTML, hasPlain, generation, patterns, result);
     funcResult.assign(result.begin(), result.end());
     return ERR_OK;
 }
@@ -2753,17 +2929,21 @@ std::pair<int32_t, ClipPlugin::GlobalEvent> PasteboardService::GetValidDistribut
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "plugin is null");
         return std::make_pair(static_cast<int32_t>(PasteboardError::PLUGIN_IS_NULL), evt);
     }
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(plugin->IsWiFiEnable(),
-        std::make_pair(static_cast<int32_t>(PasteboardError::GET_LOCAL_DATA), evt), PASTEBOARD_MODULE_SERVICE,
-        "wifi is disabled");
-    auto events = plugin->GetTopEvents(1, user);
-    if (events.empty()) {
+    using Stage = PasteboardRemoteEventCache::Stage;
+    Stage stage = Stage::NO_EVENT;
+    if (!remoteEventCache_.GetEvent(user, stage, evt)) {
+        uint64_t generation = remoteEventCache_.GetGeneration();
+        int32_t ret = ValidateTopEvent(plugin, user, stage, evt);
+        if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
+            return std::make_pair(ret, evt);
+        }
+        remoteEventCache_.StoreEvent(user, generation, stage, evt);
+    }
+    if (stage == Stage::NO_EVENT) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "plugin event is empty");
         return std::make_pair(static_cast<int32_t>(PasteboardError::PLUGIN_EVENT_EMPTY), evt);
     }
-    evt = events[0];
-    auto currentEvent = GetCurrentEvent();
-    if (evt.deviceId == DMAdapter::GetInstance().GetLocalNetworkId() || evt.expiration < currentEvent.expiration) {
+    if (stage == Stage::LOCAL_EVENT) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "get local data");
         return std::make_pair(static_cast<int32_t>(PasteboardError::GET_LOCAL_DATA), evt);
     }
@@ -2772,13 +2952,7 @@ std::pair<int32_t, ClipPlugin::GlobalEvent> PasteboardService::GetValidDistribut
         return std::make_pair(static_cast<int32_t>(PasteboardError::INVALID_EVENT_ACCOUNT), evt);
     }
 #ifdef PB_DEVICE_MANAGER_ENABLE
-    DmDeviceInfo remoteDevice;
-    int32_t ret = DMAdapter::GetInstance().GetRemoteDeviceInfo(evt.deviceId, remoteDevice);
-    if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "deviceId: %{public}.6s is offline", evt.deviceId.c_str());
-        return std::make_pair(ret, evt);
-    }
-
+    auto currentEvent = GetCurrentEvent();
     if (evt.deviceId == currentEvent.deviceId && evt.seqId == currentEvent.seqId &&
         evt.expiration == currentEvent.expiration) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "get same remote data");
@@ -2786,7 +2960,8 @@ std::pair<int32_t, ClipPlugin::GlobalEvent> PasteboardService::GetValidDistribut
     }
     uint64_t curTime =
         static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
-    ret = evt.status == ClipPlugin::EVT_NORMAL ? ret : static_cast<int32_t>(PasteboardError::INVALID_EVENT_STATUS);
+    int32_t ret = evt.status == ClipPlugin::EVT_NORMAL ? static_cast<int32_t>(PasteboardError::E_OK) :
+        static_cast<int32_t>(PasteboardError::INVALID_EVENT_STATUS);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE((curTime != 0 && evt.expiration != EXPIRATION_INTERVAL),
         std::make_pair(static_cast<int32_t>(PasteboardError::GET_BOOTTIME_FAILED), evt),
         PASTEBOARD_MODULE_SERVICE, "Failed to get the time."
@@ -2798,27 +2973,96 @@ std::pair<int32_t, ClipPlugin::GlobalEvent> PasteboardService::GetValidDistribut
 #endif
 }
 
+int32_t PasteboardService::ValidateTopEvent(const std::shared_ptr<ClipPlugin> &plugin, int32_t user,
+    PasteboardRemoteEventCache::Stage &stage, Event &evt)
+{
+    using Stage = PasteboardRemoteEventCache::Stage;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(plugin->IsWiFiEnable(), static_cast<int32_t>(PasteboardError::GET_LOCAL_DATA),
+        PASTEBOARD_MODULE_SERVICE, "wifi is disabled");
+    auto events = plugin->GetTopEvents(1, user);
+    if (events.empty()) {
+        stage = Stage::NO_EVENT;
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+    evt = events[0];
+    // the current event only changes together with an invalidation of the cache
+    auto currentEvent = GetCurrentEvent();
+    if (evt.deviceId == DMAdapter::GetInstance().GetLocalNetworkId() || evt.expiration < currentEvent.expiration) {
+        stage = Stage::LOCAL_EVENT;
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(evt.account == AccountManager::GetInstance().GetCurrentAccount(),
+        static_cast<int32_t>(PasteboardError::INVALID_EVENT_ACCOUNT), PASTEBOARD_MODULE_SERVICE, "account error");
+#ifdef PB_DEVICE_MANAGER_ENABLE
+    DmDeviceInfo remoteDevice;
+    int32_t ret = DMAdapter::GetInstance().GetRemoteDeviceInfo(evt.deviceId, remoteDevice);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
+        PASTEBOARD_MODULE_SERVICE, "deviceId: %{public}.6s is offline", evt.deviceId.c_str());
+#endif
+    stage = Stage::REMOTE_EVENT;
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
 int32_t PasteboardService::GetRemoteMimeTypes(std::vector<std::string> &mimeTypes, const Event &event)
 {
+    PasteboardRemoteEventCache::RemoteTypes types;
+    int32_t ret = GetRemoteTypes(types, event);
+    if (ret == ERR_OK) {
+        mimeTypes = std::move(types.mimeTypes);
+    }
+    return ret;
+}
+
+int32_t PasteboardService::GetRemoteTypes(PasteboardRemoteEventCache::RemoteTypes &types, const Event &event)
+{
+    if (remoteEventCache_.GetTypes(event, types)) {
+        return ERR_OK;
+    }
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "version=%{public}d, get remote mimeTypes", event.version);
     auto clipPlugin = GetClipPlugin();
     if (clipPlugin == nullptr) {
         return static_cast<int32_t>(PasteboardError::PLUGIN_IS_NULL);
     }
+    uint64_t generation = remoteEventCache_.GetGeneration();
     std::vector<uint8_t> rawData;
     auto result = clipPlugin->GetMimeTypes(rawData, event);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(result == static_cast<int32_t>(PasteboardError::E_OK),
         result, PASTEBOARD_MODULE_SERVICE, "get mimeTypes from plugin failed, result=%{public}d.", result);
-    if (event.version == ClipPlugin::InfoType::MIMETYPE) {
-        mimeTypes = DecodeMimeTypes(rawData);
+    PasteDataTypeIndex typeIndex;
+    if (DecodeTypeFrame(rawData, typeIndex)) {
+        types.mimeTypes = std::move(typeIndex.mimeTypes);
+        types.utdTypes = std::move(typeIndex.utdTypes);
+        types.hasUtdTypes = true;
+    } else if (event.version == ClipPlugin::InfoType::MIMETYPE) {
+        types.mimeTypes = DecodeMimeTypes(rawData);
     } else {
         PasteData pasteData;
         pasteData.Decode(rawData);
-        mimeTypes = pasteData.GetMimeTypes();
+        types.mimeTypes = pasteData.GetMimeTypes();
     }
+    remoteEventCache_.StoreTypes(generation, event, types);
     return ERR_OK;
 }
 
+bool PasteboardService::HasRemoteUtdType(const std::string &utdType, const Event &event, bool &hasType)
+{
+    if (event.version != ClipPlugin::InfoType::DEFAULT) {
+        PasteboardRemoteEventCache::RemoteTypes types;
+        if (GetRemoteTypes(types, event) == ERR_OK && types.hasUtdTypes) {
+            hasType = PasteDataTypeIndex::Contains(types.utdTypes, utdType);
+            return true;
+        }
+    }
+    // every entry is listed in dataType under its mime type, only the uris split from a web record are not
+    auto mimeType = CommonUtils::Convert2MimeType(utdType);
+    if (IsBasicType(mimeType) && mimeType != MIMETYPE_TEXT_URI &&
+        std::find(event.dataType.begin(), event.dataType.end(), mimeType) == event.dataType.end()) {
+        hasType = false;
+        return true;
+    }
+    return false;
+}
+
 bool PasteboardService::HasRemoteDataType(const std::string &mimeType, const Event &event)
 {
     std::vector<std::string> mimeTypes;
@@ -2880,9 +3124,7 @@ bool PasteboardService::HasLocalDataType(const std::string &mimeType, uint32_t t
             screenStatus, it.second->GetScreenStatus(), userId, mimeType.c_str());
         return false;
     }
-    std::vector<std::string> mimeTypes = it.second->GetMimeTypes();
-    auto isExistType = std::find(mimeTypes.begin(), mimeTypes.end(), mimeType) != mimeTypes.end();
-    return isExistType;
+    return it.second->HasListedMimeType(mimeType);
 }
 
 int32_t PasteboardService::IsRemoteData(bool &funcResult)
@@ -2961,8 +3203,7 @@ int32_t PasteboardService::WritePasteData(
             CloseSharedMemFd(fd);
             return static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR);
         }
-        std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-        hasData = pasteData.Decode(pasteDataTlv);
+        hasData = pasteData.Decode(rawData, static_cast<size_t>(rawDataSize));
         ::munmap(ptr, rawDataSize);
     } else {
         hasData = pasteData.Decode(buffer);
@@ -3020,7 +3261,14 @@ int32_t PasteboardService::SetPasteData(int fd, int64_t rawDataSize, const std::
     if (DisposableManager::GetInstance().TryProcessDisposableData(pasteData, delayGetter, entryGetter)) {
         return ERR_OK;
     }
-    ret = SaveData(pasteData, rawDataSize, delayGetter, entryGetter);
+    bool superseded = false;
+    ret = SaveData(pasteData, rawDataSize, delayGetter, entryGetter, superseded);
+    if (superseded) {
+        // a later set of the same user was saved instead, this data has nothing to recognize or report
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
+            PASTEBOARD_MODULE_SERVICE, "superseding set failed, ret=%{public}d", ret);
+        return ERR_OK;
+    }
     if (entityObserverMap_.Size() != 0 && pasteData.HasMimeType(MIMETYPE_TEXT_PLAIN)) {
         RecognizePasteData(pasteData);
     }
@@ -3050,6 +3298,7 @@ int32_t PasteboardService::SetPasteDataOnly(int fd, int64_t rawDataSize, const s
 
 void PasteboardService::RemovePasteData(const AppInfo &appInfo)
 {
+    uriGrantLedger_.Forget(appInfo.userId);
     delayGetters_.ComputeIfPresent(appInfo.userId, [](auto, auto &delayGetter) {
         RADAR_REPORT(DFX_SET_PASTEBOARD, DFX_CHECK_SET_DELAY_COPY, DFX_SUCCESS, COVER_DELAY_DATA, DFX_SUCCESS);
         if (delayGetter.first != nullptr && delayGetter.second != nullptr) {
@@ -3595,35 +3844,37 @@ void PasteboardService::NotifyObservers(std::string bundleName, int32_t userId,
     if (hasPid && IsNeedThaw(status)) {
         ThawInputMethod(pid);
     }
-    std::thread thread([this, bundleName, userId, status]() {
-        std::lock_guard<std::mutex> lock(observerMutex_);
-        for (auto &observers : observerLocalChangedMap_) {
-            if (observers.second == nullptr) {
-                PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observerLocalChangedMap_.second is nullptr");
-                continue;
-            }
-            for (const auto &observer : *(observers.second)) {
-                if (status != PasteboardEventStatus::PASTEBOARD_READ && userId == observers.first.first) {
-                    observer->OnPasteboardChanged();
-                }
-            }
+    std::lock_guard<std::mutex> lock(observerMutex_);
+    for (auto &observers : observerLocalChangedMap_) {
+        if (observers.second == nullptr) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observerLocalChangedMap_.second is nullptr");
+            continue;
         }
-        IPasteboardChangedObserver::PasteboardChangedEvent event;
-        event.status = static_cast<int32_t>(status);
-        event.userId = userId;
-        event.bundleName = bundleName;
-        for (auto &observers : observerEventMap_) {
-            if (observers.second == nullptr) {
-                PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observerEventMap_.second is nullptr");
-                continue;
-            }
-            for (const auto &observer : *(observers.second)) {
+        if (status == PasteboardEventStatus::PASTEBOARD_READ || userId != observers.first.first) {
+            continue;
+        }
+        for (const auto &observer : *(observers.second)) {
+            notifyExecutor_.Post(observer, "changed", [observer]() {
+                observer->OnPasteboardChanged();
+            });
+        }
+    }
+    IPasteboardChangedObserver::PasteboardChangedEvent event;
+    event.status = static_cast<int32_t>(status);
+    event.userId = userId;
+    event.bundleName = bundleName;
+    std::string eventKey = std::to_string(event.status) + "|" + std::to_string(userId) + "|" + bundleName;
+    for (auto &observers : observerEventMap_) {
+        if (observers.second == nullptr) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observerEventMap_.second is nullptr");
+            continue;
+        }
+        for (const auto &observer : *(observers.second)) {
+            notifyExecutor_.Post(observer, eventKey, [observer, event]() {
                 observer->OnPasteboardEvent(event);
-            }
+            });
         }
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NotifyObservers");
-    thread.detach();
+    }
 }
 
 bool PasteboardService::SetPasteboardHistory(HistoryInfo &info)
@@ -3766,6 +4017,85 @@ std::string PasteboardService::DumpData()
     return result;
 }
 
+std::string PasteboardService::DumpLockStats() const
+{
+    auto foregroundUsers = ResolveForegroundUsers();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!foregroundUsers.empty(), "Lock stats fail! no foreground user.",
+        PASTEBOARD_MODULE_SERVICE, "no foreground user");
+    std::string result;
+    for (const auto &ctx : foregroundUsers) {
+        if (ctx.userId == ERROR_USERID) {
+            continue;
+        }
+        result.append("UserId: ").append(std::to_string(ctx.userId)).append("\n")
+            .append(FormatStats({ { "Contention", std::to_string(PasteboardUserLock::GetContention(ctx.userId)) } }));
+    }
+    return result;
+}
+
+std::string PasteboardService::DumpSetStats() const
+{
+    auto stats = setPipeline_.GetStats();
+    return FormatStats({
+        { "Queue depth", std::to_string(stats.depth) },
+        { "Max depth", std::to_string(stats.maxDepth) },
+        { "Completed", std::to_string(stats.completed) },
+        { "Superseded", std::to_string(stats.superseded) },
+        { "Rejected", std::to_string(stats.rejected) },
+    });
+}
+
+std::string PasteboardService::DumpNotifyStats() const
+{
+    auto stats = notifyExecutor_.GetStats();
+    return FormatStats({
+        { "Pending", std::to_string(stats.pending) },
+        { "Dispatched", std::to_string(stats.dispatched) },
+        { "Avg latency", AverageMs(stats.totalLatencyMs, stats.dispatched) },
+        { "Max latency", std::to_string(stats.maxLatencyMs) + "ms" },
+        { "Coalesced", std::to_string(stats.coalesced) },
+        { "Dropped", std::to_string(stats.dropped) },
+        { "Timeouts", std::to_string(stats.timeouts) },
+    });
+}
+
+std::string PasteboardService::DumpTimerStats() const
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ffrtTimer_ != nullptr, "Timer stats fail! timer is null.",
+        PASTEBOARD_MODULE_SERVICE, "ffrtTimer_ is null");
+    auto stats = ffrtTimer_->GetStats();
+    return FormatStats({
+        { "Pending", std::to_string(stats.pending) },
+        { "Fired", std::to_string(stats.fired) },
+        { "Avg late", AverageMs(stats.totalLatenessMs, stats.fired) },
+        { "Max late", std::to_string(stats.maxLatenessMs) + "ms" },
+    });
+}
+
+std::string PasteboardService::DumpPatternStats() const
+{
+    auto stats = patternCache_.GetStats();
+    return FormatStats({
+        { "Hits", std::to_string(stats.hits) },
+        { "Misses", std::to_string(stats.misses) },
+        { "Hit rate", HitRate(stats.hits, stats.misses) },
+    });
+}
+
+std::string PasteboardService::DumpVersionStats()
+{
+    auto table = moduleConfig_.GetVersionStats();
+    auto profile = DevProfile::GetInstance().GetVersionCacheStats();
+    return FormatStats({
+        { "Table hits", std::to_string(table.hits) },
+        { "Table refreshes", std::to_string(table.refreshes) },
+        { "Table hit rate", HitRate(table.hits, table.refreshes) },
+        { "Profile hits", std::to_string(profile.hits) },
+        { "Profile misses", std::to_string(profile.misses) },
+        { "Profile hit rate", HitRate(profile.hits, profile.misses) },
+    });
+}
+
 bool PasteboardService::IsFocusedApp(uint32_t tokenId)
 {
     if (AccessTokenKit::GetTokenTypeFlag(tokenId) != ATokenTypeEnum::TOKEN_HAP) {
@@ -3835,15 +4165,11 @@ void PasteboardService::AddPreSyncP2pTimeoutTask(const std::string &networkId)
     std::string taskName = P2P_PRESYNC_ID + networkId;
     ffrtTimer_->CancelTimer(taskName);
     FFRTTask p2pTask = [this, networkId] {
-        std::thread thread([=]() {
-            PasteComplete(networkId, P2P_PRESYNC_ID);
-            std::lock_guard<std::mutex> tmpMutex(p2pMapMutex_);
-            DeletePreSyncP2pMap(networkId);
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "PasteComplete03");
-        thread.detach();
+        PasteComplete(networkId, P2P_PRESYNC_ID);
+        std::lock_guard<std::mutex> tmpMutex(p2pMapMutex_);
+        DeletePreSyncP2pMap(networkId);
     };
-    ffrtTimer_->SetTimer(taskName, p2pTask, PRE_ESTABLISH_P2P_LINK_TIME);
+    ffrtTimer_->SetBlockingTimer(taskName, p2pTask, PRE_ESTABLISH_P2P_LINK_TIME);
 }
 
 void PasteboardService::InitPlugin(std::shared_ptr<ClipPlugin> clipPlugin)
@@ -3986,13 +4312,9 @@ void PasteboardService::PreSyncSwitchMonitorCallback()
         return;
     }
     FFRTTask monitorTask = [this] {
-        std::thread thread([=]() {
-            RegisterPreSyncMonitor();
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "PreSyncSwitchMo");
-        thread.detach();
+        RegisterPreSyncMonitor();
     };
-    ffrtTimer_->SetTimer(REGISTER_PRESYNC_MONITOR, monitorTask);
+    ffrtTimer_->SetBlockingTimer(REGISTER_PRESYNC_MONITOR, monitorTask);
 }
 
 void PasteboardService::RegisterPreSyncMonitor()
@@ -4006,14 +4328,10 @@ void PasteboardService::RegisterPreSyncMonitor()
         return;
     }
     FFRTTask monitorTask = [this] {
-        std::thread thread([=]() {
-            UnRegisterPreSyncMonitor();
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "RegisterPreSync");
-        thread.detach();
+        UnRegisterPreSyncMonitor();
     };
     if (subscribeActiveId_ != INVALID_SUBSCRIBE_ID) {
-        ffrtTimer_->SetTimer(UNREGISTER_PRESYNC_MONITOR, monitorTask, PRESYNC_MONITOR_TIME);
+        ffrtTimer_->SetBlockingTimer(UNREGISTER_PRESYNC_MONITOR, monitorTask, PRESYNC_MONITOR_TIME);
         return;
     }
     std::shared_ptr<InputEventCallback> preSyncMonitor =
@@ -4029,7 +4347,7 @@ void PasteboardService::RegisterPreSyncMonitor()
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "SubscribeInputActive failed");
         return;
     }
-    ffrtTimer_->SetTimer(UNREGISTER_PRESYNC_MONITOR, monitorTask, PRESYNC_MONITOR_TIME);
+    ffrtTimer_->SetBlockingTimer(UNREGISTER_PRESYNC_MONITOR, monitorTask, PRESYNC_MONITOR_TIME);
 }
 
 void PasteboardService::UnRegisterPreSyncMonitor()
@@ -4134,15 +4452,16 @@ std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDis
         return std::make_pair(nullptr, pasteDateResult);
     }
     std::vector<uint8_t> rawData;
-    auto result = clipPlugin->GetPasteData(event, rawData);
-    if (result.first != 0) {
+    auto result = GetDistributedRawData(*clipPlugin, event, rawData);
+    bool sizeExceeded = result.first == static_cast<int32_t>(PasteboardError::REMOTE_DATA_SIZE_EXCEEDED);
+    if (result.first != 0 && !sizeExceeded) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "get data failed");
         Reporter::GetInstance().PasteboardFault().Report({ user, "GET_REMOTE_DATA_FAILED" });
         pasteDateResult.syncTime = -1;
         pasteDateResult.errorCode = result.first;
         return std::make_pair(nullptr, pasteDateResult);
     }
-    if (static_cast<int64_t>(rawData.size()) > maxLocalCapacity_.load()) {
+    if (sizeExceeded || static_cast<int64_t>(rawData.size()) > maxLocalCapacity_.load()) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "remote dataSize exceeded, dataSize=%{public}zu", rawData.size());
         pasteDateResult.syncTime = 0;
         pasteDateResult.errorCode = static_cast<int32_t>(PasteboardError::REMOTE_DATA_SIZE_EXCEEDED);
@@ -4170,6 +4489,77 @@ std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDis
     return std::make_pair(pasteData, pasteDateResult);
 }
 
+std::pair<int32_t, int32_t> PasteboardService::GetDistributedRawData(ClipPlugin &clipPlugin, const Event &event,
+    std::vector<uint8_t> &rawData)
+{
+    std::pair<int32_t, int32_t> result = std::make_pair(0, 0);
+    std::vector<uint8_t> frame;
+    auto reader = TakeDistributedChunkSink(event, result.second);
+    if (reader == nullptr) {
+        result = clipPlugin.GetPasteData(event, rawData);
+        if (result.first != 0 || !TLVChunkReader::IsChunkFrame(rawData)) {
+            return result;
+        }
+        auto maxSize = static_cast<uint64_t>(std::max<int64_t>(maxLocalCapacity_.load(), 0));
+        reader = std::make_shared<TLVChunkReader>(maxSize);
+        frame = std::move(rawData);
+        rawData.clear();
+    } else {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "resume chunks, seqId=%{public}hu, offset=%{public}" PRIu64,
+            event.seqId, reader->GetNextOffset());
+    }
+    auto deadline = steady_clock::now() + milliseconds(MAX_CHUNK_RETRY_TIME);
+    int32_t ret = 0;
+    uint32_t retry = 0;
+    while (!reader->IsComplete()) {
+        if (frame.empty()) {
+            uint32_t index = static_cast<uint32_t>(reader->GetNextOffset() / TLVChunkWriter::CHUNK_SIZE);
+            ret = clipPlugin.GetPasteDataEntry(event, index, TLVChunkWriter::CHUNK_ENTRY_TYPE, frame);
+        }
+        if (reader->Append(frame)) {
+            retry = 0;
+            frame.clear();
+            continue;
+        }
+        if (reader->IsTooLarge()) {
+            return std::make_pair(static_cast<int32_t>(PasteboardError::REMOTE_DATA_SIZE_EXCEEDED), result.second);
+        }
+        frame.clear();
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "chunk failed, offset=%{public}" PRIu64 ", ret=%{public}d, "
+            "retry=%{public}u", reader->GetNextOffset(), ret, retry);
+        auto interval = milliseconds(CHUNK_RETRY_INTERVAL * (++retry));
+        if (retry > MAX_CHUNK_RETRY || steady_clock::now() + interval > deadline) {
+            KeepDistributedChunkSink(event, result.second, reader);
+            return std::make_pair(static_cast<int32_t>(PasteboardError::REMOTE_TASK_ERROR), result.second);
+        }
+        std::this_thread::sleep_for(interval);
+    }
+    rawData = reader->TakeData();
+    return std::make_pair(0, result.second);
+}
+
+std::shared_ptr<TLVChunkReader> PasteboardService::TakeDistributedChunkSink(const Event &event, int32_t &syncTime)
+{
+    std::lock_guard<std::mutex> lock(chunkSink_.mutex);
+    std::shared_ptr<TLVChunkReader> reader = std::move(chunkSink_.reader);
+    chunkSink_.reader = nullptr;
+    if (reader == nullptr || chunkSink_.event.seqId != event.seqId || chunkSink_.event.deviceId != event.deviceId ||
+        chunkSink_.event.expiration != event.expiration) {
+        return nullptr;
+    }
+    syncTime = chunkSink_.syncTime;
+    return reader;
+}
+
+void PasteboardService::KeepDistributedChunkSink(const Event &event, int32_t syncTime,
+    std::shared_ptr<TLVChunkReader> reader)
+{
+    std::lock_guard<std::mutex> lock(chunkSink_.mutex);
+    chunkSink_.event = event;
+    chunkSink_.syncTime = syncTime;
+    chunkSink_.reader = std::move(reader);
+}
+
 bool PasteboardService::IsConstraintEnabled(int32_t user)
 {
     bool isConstraintEnabled = false;
@@ -4191,7 +4581,7 @@ bool PasteboardService::IsDisallowDistributed()
 
 bool PasteboardService::IsNeedLink(PasteData &data)
 {
-    for (const auto &record : data.AllRecords()) {
+    for (const auto &record : data.PeekRecords()) {
         if (record == nullptr) {
             continue;
         }
@@ -4314,7 +4704,7 @@ bool PasteboardService::SetCurrentData()
         GetFullDelayPasteData(currentEvent.user, currentData);
         currentEvent.isDelay = false;
         {
-            std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+            auto write = PasteboardUserLock::Write(currentEvent.user);
             std::string bundleIndex = PasteBoardCommon::GetDirByAuthority(currentData.GetOriginAuthority());
             PasteboardWebController::GetInstance().SplitWebviewPasteData(
                 currentData, bundleIndex, currentData.userId_);
@@ -4325,35 +4715,71 @@ bool PasteboardService::SetCurrentData()
     GenerateDistributedUri(currentData);
     currentEvent.notNeedLink = !IsNeedLink(currentData);
     std::vector<uint8_t> rawData;
+    std::vector<uint8_t> rawMimeTypes;
     auto remoteVersionMin = moduleConfig_.GetRemoteDeviceMinVersion();
     {
-        std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+        auto read = PasteboardUserLock::Read(currentEvent.user);
         if (!currentData.Encode(rawData, remoteVersionMin <= DistributedModuleConfig::Version::VERSION_FIVE)) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
                 "distributed data encode failed, dataId:%{public}u, seqId:%{public}hu",
                 currentEvent.dataId, currentEvent.seqId);
             return false;
         }
+        rawMimeTypes = EncodeRemoteMimeTypes(currentData, rawData.size(), remoteVersionMin);
     }
-    if (currentData.IsDelayRecord() && !needFull) {
+    bool chunked = remoteVersionMin >= DistributedModuleConfig::Version::VERSION_SEVEN &&
+        rawData.size() > TLVChunkWriter::CHUNK_SIZE;
+    if ((currentData.IsDelayRecord() && !needFull) || chunked) {
         clipPlugin->RegisterDelayCallback(
             std::bind(&PasteboardService::GetDistributedDelayData, this, std::placeholders::_1,
                 std::placeholders::_2, std::placeholders::_3),
             std::bind(&PasteboardService::GetDistributedDelayEntry, this, std::placeholders::_1,
                 std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
     }
-    std::vector<uint8_t> rawMimeTypes;
-    if (rawData.size() > MAX_TRANSFER_SIZE) {
-        auto mimeTypes = currentData.GetMimeTypes();
-        rawMimeTypes = EncodeMimeTypes(mimeTypes);
+    if (!chunked) {
+        SetDistributedChunkSource(currentEvent, nullptr);
+        clipPlugin->SetPasteData(currentEvent, rawData, remoteVersionMin, rawMimeTypes);
+        return true;
     }
-    clipPlugin->SetPasteData(currentEvent, rawData, remoteVersionMin, rawMimeTypes);
+    auto writer = std::make_shared<TLVChunkWriter>(std::move(rawData));
+    std::vector<uint8_t> firstFrame;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(writer->GetChunk(0, firstFrame), false, PASTEBOARD_MODULE_SERVICE,
+        "cut first chunk failed, seqId:%{public}hu", currentEvent.seqId);
+    SetDistributedChunkSource(currentEvent, writer);
+    clipPlugin->SetPasteData(currentEvent, firstFrame, remoteVersionMin, rawMimeTypes);
     return true;
 }
 
+void PasteboardService::SetDistributedChunkSource(const Event &event, std::shared_ptr<TLVChunkWriter> writer)
+{
+    std::lock_guard<std::mutex> lock(chunkSource_.mutex);
+    chunkSource_.event = event;
+    chunkSource_.writer = std::move(writer);
+}
+
+int32_t PasteboardService::GetDistributedChunk(const Event &evt, uint64_t offset, std::vector<uint8_t> &frame)
+{
+    std::shared_ptr<TLVChunkWriter> writer;
+    {
+        std::lock_guard<std::mutex> lock(chunkSource_.mutex);
+        if (chunkSource_.event.seqId == evt.seqId && chunkSource_.event.deviceId == evt.deviceId) {
+            writer = chunkSource_.writer;
+        }
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(writer != nullptr, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "chunk source not find, seqId=%{public}hu", evt.seqId);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(writer->GetChunk(offset, frame),
+        static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "get chunk failed, seqId=%{public}hu, offset=%{public}" PRIu64, evt.seqId, offset);
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
 int32_t PasteboardService::GetDistributedDelayEntry(const Event &evt, uint32_t recordId, const std::string &utdId,
     std::vector<uint8_t> &rawData)
 {
+    if (utdId == TLVChunkWriter::CHUNK_ENTRY_TYPE) {
+        return GetDistributedChunk(evt, static_cast<uint64_t>(recordId) * TLVChunkWriter::CHUNK_SIZE, rawData);
+    }
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "dataId:%{public}u, seqId:%{public}hu, expiration:%{public}" PRIu64
         ", recordId:%{public}u, type:%{public}s", evt.dataId, evt.seqId, evt.expiration, recordId, utdId.c_str());
     auto [hasData, data] = clips_.Find(evt.user);
@@ -4363,7 +4789,7 @@ int32_t PasteboardService::GetDistributedDelayEntry(const Event &evt, uint32_t r
         static_cast<int32_t>(PasteboardError::INVALID_DATA_ID), PASTEBOARD_MODULE_SERVICE,
         "dataId=%{public}u mismatch, local=%{public}u", evt.dataId, data->GetDataId());
 
-    auto record = data->GetRecordById(recordId);
+    auto record = data->PeekRecordById(recordId);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(record != nullptr, static_cast<int32_t>(PasteboardError::INVALID_RECORD_ID),
         PASTEBOARD_MODULE_SERVICE, "recordId=%{public}u invalid, max=%{public}zu", recordId, data->GetRecordCount());
 
@@ -4398,9 +4824,10 @@ int32_t PasteboardService::ProcessDistributedDelayUri(int32_t userId, PasteData
         PASTEBOARD_MODULE_SERVICE, "convert entry to uri failed");
 
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(userId);
+        InvalidateEncodedClip(userId);
         PasteboardWebController::GetInstance().CheckAppUriPermission(data);
-        auto item = data.GetRecordById(recordId);
+        auto item = data.PeekRecordById(recordId);
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(item != nullptr, static_cast<int32_t>(PasteboardError::INVALID_RECORD_ID),
             PASTEBOARD_MODULE_SERVICE, "record[%{public}u]invalid, max=%{public}zu", recordId, data.GetRecordCount());
         bool hasUriPerm = item->HasGrantUriPermission();
@@ -4444,7 +4871,8 @@ int32_t PasteboardService::ProcessDistributedDelayHtml(PasteData &data, PasteDat
     std::vector<uint8_t> &rawData)
 {
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(data.userId_);
+        InvalidateEncodedClip(data.userId_);
         std::string bundleIndex = PasteBoardCommon::GetDirByAuthority(data.GetOriginAuthority());
         if (PasteboardWebController::GetInstance().SplitWebviewPasteData(data, bundleIndex, data.userId_)) {
             PasteboardWebController::GetInstance().SetWebviewPasteData(data, bundleIndex);
@@ -4516,7 +4944,8 @@ int32_t PasteboardService::GetDistributedDelayData(const Event &evt, uint8_t ver
         PASTEBOARD_MODULE_SERVICE, "get delay data failed, version=%{public}hhu", version);
 
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(evt.user);
+        data->UnshareRecords();
         auto authorityInfo = data->GetOriginAuthority();
         data->SetBundleInfo(authorityInfo.first, authorityInfo.second);
         std::string bundleIndex = PasteBoardCommon::GetDirByAuthority(authorityInfo);
@@ -4525,9 +4954,11 @@ int32_t PasteboardService::GetDistributedDelayData(const Event &evt, uint8_t ver
         PasteboardWebController::GetInstance().CheckAppUriPermission(*data);
     }
     GenerateDistributedUri(*data);
+    // the stored clip itself was split and given distributed uris above
+    InvalidateEncodedClip(evt.user);
 
     auto remoteVersionMin = moduleConfig_.GetRemoteDeviceMinVersion();
-    std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+    auto read = PasteboardUserLock::Read(evt.user);
     bool encodeSucc = data->Encode(rawData, remoteVersionMin <= DistributedModuleConfig::Version::VERSION_FIVE);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(encodeSucc, static_cast<int32_t>(PasteboardError::DATA_ENCODE_ERROR),
         PASTEBOARD_MODULE_SERVICE, "encode data failed, dataId:%{public}u, seqId:%{public}hu", evt.dataId, evt.seqId);
@@ -4562,7 +4993,8 @@ int32_t PasteboardService::GetLocalEntryValue(int32_t userId, PasteData &data, P
         PASTEBOARD_MODULE_SERVICE, "get local entry failed, type=%{public}s, ret=%{public}d", utdId.c_str(), ret);
 
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(userId);
+        InvalidateEncodedClip(userId);
         if (data.rawDataSize_ + value.rawDataSize_ < maxLocalCapacity_.load()) {
             record.AddEntry(utdId, std::make_shared<PasteDataEntry>(value));
             data.rawDataSize_ += value.rawDataSize_;
@@ -4606,7 +5038,8 @@ int32_t PasteboardService::GetRemoteEntryValue(const AppInfo &appInfo, PasteData
     entry.SetValue(tmpEntry.GetValue());
     entry.rawDataSize_ = static_cast<int64_t>(rawData.size());
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(appInfo.userId);
+        InvalidateEncodedClip(appInfo.userId);
         if (data.rawDataSize_ + entry.rawDataSize_ < maxLocalCapacity_.load()) {
             record.AddEntry(utdId, std::make_shared<PasteDataEntry>(entry));
             data.rawDataSize_ += entry.rawDataSize_;
@@ -4648,7 +5081,7 @@ int32_t PasteboardService::ProcessRemoteDelayUri(const std::string &deviceId, co
         data, std::make_pair(appInfo.bundleName, appInfo.appIndex));
     if (!grantUris.empty()) {
         EstablishP2PLink(deviceId, data.GetPasteId());
-        int32_t ret = GrantUriPermission(grantUris, appInfo.tokenId, data.IsRemote());
+        int32_t ret = GrantUriPermission(grantUris, appInfo.tokenId, data.IsRemote(), data.GetDataId());
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
             PASTEBOARD_MODULE_SERVICE, "grant remote uri failed, uri=%{private}s, ret=%{public}d",
             distributedUri.c_str(), ret);
@@ -4670,7 +5103,8 @@ int32_t PasteboardService::ProcessRemoteDelayHtml(const std::string &remoteDevic
     entry.SetValue(htmlEntry->GetValue());
     entry.rawDataSize_ = static_cast<int64_t>(rawData.size());
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(appInfo.userId);
+        InvalidateEncodedClip(appInfo.userId);
         if (data.rawDataSize_ + entry.rawDataSize_ < maxLocalCapacity_.load()) {
             record.AddEntry(entry.GetUtdId(), std::make_shared<PasteDataEntry>(entry));
             data.rawDataSize_ += entry.rawDataSize_;
@@ -4722,7 +5156,7 @@ int32_t PasteboardService::ProcessRemoteDelayHtmlInner(const std::string &remote
         data, std::make_pair(appInfo.bundleName, appInfo.appIndex));
     if (!grantUris.empty()) {
         EstablishP2PLink(remoteDeviceId, data.GetPasteId());
-        int32_t ret = GrantUriPermission(grantUris, appInfo.tokenId, data.IsRemote());
+        int32_t ret = GrantUriPermission(grantUris, appInfo.tokenId, data.IsRemote(), data.GetDataId());
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
             PASTEBOARD_MODULE_SERVICE, "grant to %{public}s failed, ret=%{public}d", appInfo.bundleName.c_str(), ret);
     }
@@ -4749,13 +5183,14 @@ int32_t PasteboardService::GetFullDelayPasteData(int32_t userId, PasteData &data
         PASTEBOARD_MODULE_SERVICE, "no delay entry");
     DelayManager::GetLocalEntryValue(delayEntryInfos, getter.first, data);
     {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(userId);
         std::string bundleIndex = PasteBoardCommon::GetDirByAuthority(data.GetOriginAuthority());
         PasteboardWebController::GetInstance().SplitWebviewPasteData(data, bundleIndex, userId);
         PasteboardWebController::GetInstance().SetWebviewPasteData(data, bundleIndex);
         PasteboardWebController::GetInstance().CheckAppUriPermission(data);
     }
-    clips_.ComputeIfPresent(userId, [&data](auto, auto &value) {
+    bool replaced = false;
+    clips_.ComputeIfPresent(userId, [&data, &replaced](auto, auto &value) {
         if (data.GetDataId() != value->GetDataId()) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
                 "set data fail, data is out time, pre dataId is %{public}d, cur dataId is %{public}d",
@@ -4763,8 +5198,13 @@ int32_t PasteboardService::GetFullDelayPasteData(int32_t userId, PasteData &data
             return true;
         }
         value = std::make_shared<PasteData>(data);
+        value->BuildTypeIndex();
+        replaced = true;
         return true;
     });
+    if (replaced) {
+        InvalidateEncodedClip(userId);
+    }
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
 
@@ -4784,9 +5224,11 @@ int32_t PasteboardService::SyncDelayedData()
         PASTEBOARD_MODULE_SERVICE, "get full delay failed, ret=%{public}d", ret);
 
     std::thread thread([=, userId = appInfo.userId, data = data] {
-        std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+        auto write = PasteboardUserLock::Write(userId);
+        InvalidateEncodedClip(userId);
         PASTEBOARD_CHECK_AND_RETURN_LOGE(data != nullptr, PASTEBOARD_MODULE_SERVICE, "sync delayed data is null");
         data->RemoveEmptyEntry();
+        data->BuildTypeIndex();
         clips_.ComputeIfPresent(userId, [=](auto, auto &value) {
             if (data->GetDataId() == value->GetDataId()) {
                 value = std::move(data);
@@ -4805,9 +5247,10 @@ void PasteboardService::GenerateDistributedUri(PasteData &data)
     std::vector<size_t> indexes;
     auto userId = GetAppInfo(IPCSkeleton::GetCallingTokenID()).userId;
     PASTEBOARD_CHECK_AND_RETURN_LOGE(userId != ERROR_USERID, PASTEBOARD_MODULE_SERVICE, "invalid userId");
-    std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
+    auto write = PasteboardUserLock::Write(userId);
+    data.UnshareRecords();
     for (size_t i = 0; i < data.GetRecordCount(); i++) {
-        auto item = data.GetRecordAt(i);
+        auto item = data.PeekRecordAt(i);
         if (item == nullptr) {
             continue;
         }
@@ -4837,7 +5280,7 @@ void PasteboardService::GenerateDistributedUri(PasteData &data)
                 ret, userId, uris.size());
         }
         for (size_t i = 0; i < indexes.size(); i++) {
-            auto item = data.GetRecordAt(indexes[i]);
+            auto item = data.PeekRecordAt(indexes[i]);
             if (item == nullptr) {
                 continue;
             }
@@ -4892,6 +5335,8 @@ void PasteboardService::CleanDistributedData(int32_t user)
         return;
     }
     clipPlugin->Clear(user);
+    remoteEventCache_.Invalidate();
+    SetDistributedChunkSource(Event(), nullptr);
 }
 
 bool PasteboardService::IsValidCurrentEvent()
@@ -4911,6 +5356,7 @@ void PasteboardService::CloseDistributedStore(int32_t user, bool isNeedClear)
         clipPlugin_->Clear(user);
     }
     clipPlugin_->Close(user);
+    remoteEventCache_.Invalidate();
 }
 
 void PasteboardService::OnConfigChange(bool isOn)
@@ -4925,6 +5371,7 @@ void PasteboardService::OnConfigChange(bool isOn)
 void PasteboardService::OnConfigChangeInner(bool isOn)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "ConfigChange isOn: %{public}d.", isOn);
+    remoteEventCache_.Invalidate();
     if (!isOn) {
         std::lock_guard<std::mutex> tmpMutex(p2pMapMutex_);
         p2pMap_.ForEach([this](const auto &deviceId, auto &value) {
@@ -5005,6 +5452,7 @@ void PasteboardService::ChangeStoreStatus(int32_t userId)
         return;
     }
     clipPlugin->ChangeStoreStatus(userId);
+    remoteEventCache_.Invalidate();
 }
 
 ClipPlugin::GlobalEvent PasteboardService::GetCurrentEvent() const
@@ -5017,6 +5465,7 @@ void PasteboardService::SetCurrentEvent(ClipPlugin::GlobalEvent event)
 {
     std::lock_guard<std::mutex> lock(currentEventMutex_);
     currentEvent_ = std::move(event);
+    remoteEventCache_.Invalidate();
 }
 
 void PasteBoardCommonEventSubscriber::OnReceiveEvent(const EventFwk::CommonEventData &data)
@@ -5133,6 +5582,7 @@ void PasteboardService::ClearUriOnUninstall(int32_t userId, int32_t tokenId)
 {
     PASTEBOARD_CHECK_AND_RETURN_LOGE(tokenId >= 0, PASTEBOARD_MODULE_SERVICE, "tokenId is invalid");
     PASTEBOARD_CHECK_AND_RETURN_LOGE(userId != ERROR_USERID, PASTEBOARD_MODULE_SERVICE, "userId is invalid");
+    uriGrantLedger_.ForgetToken(static_cast<uint32_t>(tokenId));
     clips_.ComputeIfPresent(userId, [this, tokenId, userId](auto, auto &pasteData) {
         if (pasteData == nullptr) {
             return true;
@@ -5142,6 +5592,7 @@ void PasteboardService::ClearUriOnUninstall(int32_t userId, int32_t tokenId)
         }
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "clear uri, tokenId=%{public}d, userId=%{public}d",
             tokenId, userId);
+        uriGrantLedger_.Forget(userId);
         ClearUriOnUninstall(pasteData);
         delayGetters_.ComputeIfPresent(userId, [](auto, auto &delayGetter) {
             if (delayGetter.first != nullptr && delayGetter.second != nullptr) {
@@ -5164,11 +5615,13 @@ void PasteboardService::ClearUriOnUninstall(std::shared_ptr<PasteData> pasteData
     PASTEBOARD_CHECK_AND_RETURN_LOGE(pasteData != nullptr, PASTEBOARD_MODULE_SERVICE, "pasteData is null");
     std::thread thread([pasteData, this]() {
         {
-            std::unique_lock<std::shared_mutex> threadWriteLock(pasteDataMutex_);
+            auto threadWriteLock = PasteboardUserLock::Write(pasteData->GetUserId());
+            InvalidateEncodedClip(pasteData->GetUserId());
             if (!pasteData->HasMimeType(MIMETYPE_TEXT_URI)) {
                 return;
             }
 
+            pasteData->UnshareRecords();
             auto emptyUri = std::make_shared<OHOS::Uri>("");
             size_t recordCount = pasteData->GetRecordCount();
             for (size_t i = 0; i < recordCount; i++) {
@@ -5183,6 +5636,7 @@ void PasteboardService::ClearUriOnUninstall(std::shared_ptr<PasteData> pasteData
         std::lock_guard<decltype(mutex)> lockGuard(mutex);
         PASTEBOARD_CHECK_AND_RETURN_LOGE(clipPlugin_ != nullptr, PASTEBOARD_MODULE_SERVICE, "clipPlugin is null");
         clipPlugin_->Clear(pasteData->userId_);
+        remoteEventCache_.Invalidate();
     });
     PasteBoardCommonUtils::SetThreadTaskName(thread, "ClearUriUninsta");
     thread.detach();
@@ -5343,6 +5797,8 @@ int32_t PasteboardService::AppExit(pid_t pid, int32_t userId)
     RemoveObserverByPid(userId, pid, observerRemoteChangedMap_);
     RemoveObserverByPid(COMMON_USERID, pid, observerEventMap_);
     entityObserverMap_.Erase(pid);
+    entityRecognizer_.NotifyObserverChanged();
+    uriGrantLedger_.ForgetPid(pid);
     DisposableManager::GetInstance().RemoveDisposableInfo(pid, false);
     ClearInputMethodPidByPid(userId, pid);
     std::vector<std::string> networkIds;
@@ -5413,10 +5869,13 @@ std::function<void(const OHOS::MiscServices::Event &)> PasteboardService::Remote
 {
     return [this](const OHOS::MiscServices::Event &event) {
         (void)event;
+        remoteEventCache_.Invalidate();
         std::lock_guard<std::mutex> lock(observerMutex_);
         for (auto &observers : observerRemoteChangedMap_) {
             for (const auto &observer : *(observers.second)) {
-                observer->OnPasteboardChanged();
+                notifyExecutor_.Post(observer, "changed", [observer]() {
+                    observer->OnPasteboardChanged();
+                });
             }
         }
     };
@@ -5489,6 +5948,54 @@ std::vector<std::string> PasteboardService::DecodeMimeTypes(const std::vector<ui
     return mimeTypes;
 }
 
+std::vector<uint8_t> PasteboardService::EncodeRemoteMimeTypes(PasteData &data, size_t rawSize,
+    uint32_t remoteVersion)
+{
+    if (rawSize <= MAX_TRANSFER_SIZE) {
+        return {};
+    }
+    if (remoteVersion >= DistributedModuleConfig::Version::VERSION_SEVEN) {
+        auto frame = EncodeTypeFrame(data);
+        if (!frame.empty() && frame.size() <= MAX_TRANSFER_SIZE) {
+            return frame;
+        }
+    }
+    return EncodeMimeTypes(data.GetMimeTypes());
+}
+
+std::vector<uint8_t> PasteboardService::EncodeTypeFrame(PasteData &data)
+{
+    PasteDataTypeIndex typeIndex;
+    auto cached = data.GetTypeIndex();
+    if (cached == nullptr) {
+        data.BuildTypeIndex();
+        cached = data.GetTypeIndex();
+    }
+    if (cached != nullptr) {
+        typeIndex = *cached;
+    }
+    typeIndex.recordSizes.reserve(data.GetRecordCount());
+    for (size_t i = 0; i < data.GetRecordCount(); ++i) {
+        auto record = data.PeekRecordAt(i);
+        typeIndex.recordSizes.push_back(record == nullptr ? 0 : static_cast<int64_t>(record->Count()));
+    }
+    std::vector<uint8_t> body;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(typeIndex.Encode(body), {}, PASTEBOARD_MODULE_SERVICE,
+        "encode type frame failed, dataId=%{public}u", data.GetDataId());
+    std::vector<uint8_t> frame(std::begin(ClipPlugin::TYPE_FRAME_HEAD), std::end(ClipPlugin::TYPE_FRAME_HEAD));
+    frame.insert(frame.end(), body.begin(), body.end());
+    return frame;
+}
+
+bool PasteboardService::DecodeTypeFrame(const std::vector<uint8_t> &rawData, PasteDataTypeIndex &typeIndex)
+{
+    if (!ClipPlugin::IsTypeFrame(rawData)) {
+        return false;
+    }
+    constexpr size_t headSize = sizeof(ClipPlugin::TYPE_FRAME_HEAD);
+    return typeIndex.Decode(rawData.data() + headSize, rawData.size() - headSize);
+}
+
 void InputEventCallback::OnKeyInputEventForPaste(std::shared_ptr<MMI::KeyEvent> keyEvent) const
 {
     auto keyItems = keyEvent->GetKeyItems();
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_set_pipeline.h"
+
+#include <algorithm>
+
+#include "pasteboard_error.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+PasteboardSetPipeline::PasteboardSetPipeline(size_t capacity) : capacity_(capacity)
+{
+}
+
+int32_t PasteboardSetPipeline::Submit(int32_t userId, const std::function<int32_t()> &task, bool &superseded)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(task != nullptr, static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "task is null");
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto &queue = queues_[userId];
+    if (queue.waiting >= capacity_) {
+        stats_.rejected++;
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "set queue is full, userId=%{public}d, waiting=%{public}zu",
+            userId, queue.waiting);
+        return static_cast<int32_t>(PasteboardError::TASK_PROCESSING);
+    }
+    if (queue.next != nullptr) {
+        stats_.superseded++;
+    } else {
+        queue.next = std::make_shared<Outcome>();
+    }
+    auto outcome = queue.next;
+    uint64_t ticket = ++ticket_;
+    queue.nextTicket = ticket;
+    queue.waiting++;
+    depth_++;
+    stats_.maxDepth = std::max(stats_.maxDepth, depth_);
+    queue.cond.wait(lock, [&queue, &outcome, ticket] {
+        return outcome->done || (!queue.running && queue.nextTicket == ticket);
+    });
+    depth_--;
+    superseded = outcome->done;
+    if (!superseded) {
+        outcome->result = Run(queue, lock, task);
+        outcome->done = true;
+        queue.cond.notify_all();
+    } else {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "set superseded, userId=%{public}d, ret=%{public}d", userId,
+            outcome->result);
+    }
+    queue.waiting--;
+    if (queue.waiting == 0) {
+        queues_.erase(userId);
+    }
+    return outcome->result;
+}
+
+int32_t PasteboardSetPipeline::Run(UserQueue &queue, std::unique_lock<std::mutex> &lock,
+    const std::function<int32_t()> &task)
+{
+    queue.next = nullptr;
+    queue.running = true;
+    lock.unlock();
+    int32_t ret = task();
+    lock.lock();
+    queue.running = false;
+    stats_.completed++;
+    return ret;
+}
+
+PasteboardSetPipeline::Stats PasteboardSetPipeline::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.depth = depth_;
+    return stats;
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_uri_grant_ledger.h"
+
+namespace OHOS::MiscServices {
+std::vector<Uri> PasteboardUriGrantLedger::FilterGranted(int32_t userId, uint32_t dataId, const Target &target,
+    const std::vector<Uri> &uris) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto ledger = ledgers_.find(userId);
+    if (ledger == ledgers_.end() || ledger->second.dataId != dataId) {
+        return uris;
+    }
+    auto granted = ledger->second.granted.find(target);
+    if (granted == ledger->second.granted.end()) {
+        return uris;
+    }
+    std::vector<Uri> result;
+    for (const auto &uri : uris) {
+        if (granted->second.count(uri.ToString()) == 0) {
+            result.emplace_back(uri);
+        }
+    }
+    return result;
+}
+
+void PasteboardUriGrantLedger::Record(int32_t userId, uint32_t dataId, const Target &target,
+    const std::vector<Uri> &uris)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &ledger = ledgers_[userId];
+    if (ledger.dataId != dataId) {
+        ledger.dataId = dataId;
+        ledger.granted.clear();
+    }
+    auto &granted = ledger.granted[target];
+    for (const auto &uri : uris) {
+        granted.insert(uri.ToString());
+    }
+}
+
+void PasteboardUriGrantLedger::Forget(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ledgers_.erase(userId);
+}
+
+void PasteboardUriGrantLedger::ForgetToken(uint32_t tokenId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[userId, ledger] : ledgers_) {
+        for (auto it = ledger.granted.begin(); it != ledger.granted.end();) {
+            it = it->first.tokenId == tokenId ? ledger.granted.erase(it) : std::next(it);
+        }
+    }
+}
+
+void PasteboardUriGrantLedger::ForgetPid(pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[userId, ledger] : ledgers_) {
+        for (auto it = ledger.granted.begin(); it != ledger.granted.end();) {
+            it = it->first.pid == pid ? ledger.granted.erase(it) : std::next(it);
+        }
+    }
+}
+
+size_t PasteboardUriGrantLedger::GetGrantedCount(int32_t userId) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto ledger = ledgers_.find(userId);
+    if (ledger == ledgers_.end()) {
+        return 0;
+    }
+    size_t count = 0;
+    for (const auto &[target, uris] : ledger->second.granted) {
+        count += uris.size();
+    }
+    return count;
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clip_plugin_fake.h"
+
+namespace OHOS::MiscServices {
+int32_t ClipPluginFake::SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data, uint32_t version,
+    const std::vector<uint8_t> &mimeTypes)
+{
+    (void)version;
+    StoredClip clip;
+    clip.event = event;
+    if (IsTypeFrame(mimeTypes)) {
+        clip.event.version = InfoType::TYPE_INDEX;
+    } else if (!mimeTypes.empty()) {
+        clip.event.version = InfoType::MIMETYPE;
+    }
+    clip.data = data;
+    clip.mimeTypes = mimeTypes;
+    std::lock_guard<std::mutex> lock(mutex_);
+    clips_[event.user] = std::move(clip);
+    return 0;
+}
+
+std::pair<int32_t, int32_t> ClipPluginFake::GetPasteData(const GlobalEvent &event, std::vector<uint8_t> &data)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    getPasteDataCount_++;
+    auto clip = FindClip(event);
+    if (clip != nullptr) {
+        data = clip->data;
+    }
+    return std::make_pair(0, 0);
+}
+
+void ClipPluginFake::RegisterDelayCallback(const DelayDataCallback &dataCallback,
+    const DelayEntryCallback &entryCallback)
+{
+    (void)dataCallback;
+    std::lock_guard<std::mutex> lock(mutex_);
+    entryCallback_ = entryCallback;
+}
+
+int32_t ClipPluginFake::GetPasteDataEntry(const GlobalEvent &event, uint32_t recordId, const std::string &utdId,
+    std::vector<uint8_t> &rawData)
+{
+    DelayEntryCallback callback;
+    GlobalEvent storedEvent;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto clip = FindClip(event);
+        if (clip != nullptr) {
+            callback = entryCallback_;
+            storedEvent = clip->event;
+        }
+    }
+    if (callback == nullptr) {
+        return ClipPlugin::GetPasteDataEntry(event, recordId, utdId, rawData);
+    }
+    return callback(storedEvent, recordId, utdId, rawData);
+}
+
+std::vector<ClipPluginFake::GlobalEvent> ClipPluginFake::GetTopEvents(uint32_t topN, int32_t user)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = clips_.find(static_cast<uint16_t>(user));
+    if (topN == 0 || it == clips_.end()) {
+        return std::vector<GlobalEvent>();
+    }
+    return std::vector<GlobalEvent>{ it->second.event };
+}
+
+void ClipPluginFake::Clear(int32_t user)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    clips_.erase(static_cast<uint16_t>(user));
+}
+
+int32_t ClipPluginFake::GetMimeTypes(std::vector<uint8_t> &mimeTypes, const GlobalEvent &event)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto clip = FindClip(event);
+    if (clip != nullptr) {
+        mimeTypes = clip->mimeTypes;
+    }
+    return 0;
+}
+
+bool ClipPluginFake::IsWiFiEnable()
+{
+    return true;
+}
+
+uint32_t ClipPluginFake::GetPasteDataCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return getPasteDataCount_;
+}
+
+const ClipPluginFake::StoredClip *ClipPluginFake::FindClip(const GlobalEvent &event) const
+{
+    auto it = clips_.find(event.user);
+    if (it == clips_.end() || it->second.event.seqId != event.seqId || it->second.event.deviceId != event.deviceId) {
+        return nullptr;
+    }
+    return &it->second;
+}
+} // namespace OHOS::MiscServices
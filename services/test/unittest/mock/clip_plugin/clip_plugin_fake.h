@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLIP_PLUGIN_FAKE_H
+#define CLIP_PLUGIN_FAKE_H
+
+#include <map>
+#include <mutex>
+
+#include "clip/clip_plugin.h"
+
+namespace OHOS::MiscServices {
+// Loopback plugin for the distributed paths: it keeps the last clip of each user and serves it back as the top
+// event, and hands entry requests to the registered entry callback like a peer would.
+class ClipPluginFake : public ClipPlugin {
+public:
+    int32_t SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data, uint32_t version,
+        const std::vector<uint8_t> &mimeTypes) override;
+    std::pair<int32_t, int32_t> GetPasteData(const GlobalEvent &event, std::vector<uint8_t> &data) override;
+    void RegisterDelayCallback(const DelayDataCallback &dataCallback, const DelayEntryCallback &entryCallback) override;
+    int32_t GetPasteDataEntry(const GlobalEvent &event, uint32_t recordId, const std::string &utdId,
+        std::vector<uint8_t> &rawData) override;
+    std::vector<GlobalEvent> GetTopEvents(uint32_t topN, int32_t user) override;
+    void Clear(int32_t user) override;
+    int32_t GetMimeTypes(std::vector<uint8_t> &mimeTypes, const GlobalEvent &event) override;
+    bool IsWiFiEnable() override;
+    uint32_t GetPasteDataCount() const;
+
+private:
+    struct StoredClip {
+        GlobalEvent event;
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> mimeTypes;
+    };
+
+    const StoredClip *FindClip(const GlobalEvent &event) const;
+
+    mutable std::mutex mutex_;
+    std::map<uint16_t, StoredClip> clips_;
+    DelayEntryCallback entryCallback_;
+    uint32_t getPasteDataCount_ = 0;
+};
+} // namespace OHOS::MiscServices
+#endif // CLIP_PLUGIN_FAKE_H
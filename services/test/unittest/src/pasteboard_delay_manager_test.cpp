@@ -30,8 +30,6 @@ const std::string UTDID_HTML = "general.html";
 const std::string UTDID_FILE_URI = "general.file-uri";
 const std::string UTDID_PIXEL_MAP = "openharmony.pixel-map";
 
-std::shared_mutex PasteboardService::pasteDataMutex_;
-
 class PasteboardDelayManagerTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -81,6 +79,29 @@ public:
     }
 };
 
+class BatchEntryGetterImpl : public EntryGetterImpl {
+public:
+    int32_t GetRecordValuesByType(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+        std::vector<PasteDataEntry> &values, std::vector<int32_t> &results) override
+    {
+        ++batchCount_;
+        maxSizes_.push_back(maxSize);
+        if (failCount_ > 0) {
+            --failCount_;
+            return static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+        }
+        results.resize(recordIds.size());
+        for (size_t i = 0; i < recordIds.size(); ++i) {
+            results[i] = GetRecordValueByType(recordIds[i], values[i]);
+        }
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+
+    uint32_t batchCount_ = 0;
+    uint32_t failCount_ = 0;
+    std::vector<int64_t> maxSizes_;
+};
+
 /**
  * @tc.name: GetEntryPriorityTest001
  * @tc.desc:
@@ -306,4 +327,97 @@ HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest001, TestSize.Level1)
     EXPECT_EQ(pasteData.rawDataSize_, finalDataSize);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest001 end");
 }
+
+/**
+ * @tc.name: GetLocalEntryValueTest002
+ * @tc.desc: entries are fetched in one batch and committed in priority order
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest002 start");
+    uint64_t initDataSize = 100;
+    uint64_t finalDataSize = 1100;
+    auto entryGetter = sptr<BatchEntryGetterImpl>::MakeSptr();
+    PasteData pasteData;
+    pasteData.rawDataSize_ = initDataSize;
+
+    std::vector<DelayEntryInfo> delayEntryInfos = {};
+    constexpr uint32_t entryNum = 4;
+    for (uint32_t i = 0; i < entryNum; ++i) {
+        auto entry = std::make_shared<PasteDataEntry>();
+        entry->SetUtdId(UTDID_PLAIN_TEXT);
+        delayEntryInfos.push_back({1, i + 1, entry});
+    }
+
+    DelayManager::GetLocalEntryValue(delayEntryInfos, entryGetter, pasteData);
+    EXPECT_EQ(entryGetter->batchCount_, 1);
+    EXPECT_EQ(pasteData.rawDataSize_, finalDataSize);
+    EXPECT_EQ(delayEntryInfos[1].entry->rawDataSize_, 1000);
+    EXPECT_EQ(delayEntryInfos[2].entry->rawDataSize_, 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest002 end");
+}
+
+/**
+ * @tc.name: GetLocalEntryValueTest003
+ * @tc.desc: a failed batch is fetched one by one without giving up the batch call, within the size budget
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest003, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest003 start");
+    constexpr int64_t initDataSize = 100;
+    constexpr int64_t entrySize = 1000;
+    constexpr uint32_t entryNum = 33;
+    auto entryGetter = sptr<BatchEntryGetterImpl>::MakeSptr();
+    entryGetter->failCount_ = 1;
+    PasteData pasteData;
+    pasteData.rawDataSize_ = initDataSize;
+
+    std::vector<DelayEntryInfo> delayEntryInfos = {};
+    constexpr uint32_t recordId = 2;
+    for (uint32_t i = 0; i < entryNum; ++i) {
+        auto entry = std::make_shared<PasteDataEntry>();
+        entry->SetUtdId(UTDID_PLAIN_TEXT);
+        delayEntryInfos.push_back({1, recordId, entry});
+    }
+
+    DelayManager::GetLocalEntryValue(delayEntryInfos, entryGetter, pasteData);
+    EXPECT_EQ(entryGetter->batchCount_, 2);
+    ASSERT_EQ(entryGetter->maxSizes_.size(), 2);
+    EXPECT_EQ(entryGetter->maxSizes_[0], MessageParcelWarp::GetRawDataSize() - initDataSize);
+    EXPECT_EQ(pasteData.rawDataSize_, initDataSize + entrySize * entryNum);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest003 end");
+}
+
+/**
+ * @tc.name: GetLocalEntryValueTest004
+ * @tc.desc: single entry fetches skip only the entry that does not fit and keep fetching the later chunks
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest004, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest004 start");
+    constexpr int64_t initDataSize = 100;
+    constexpr int64_t entrySize = 1000;
+    constexpr uint32_t entryNum = 40;
+    constexpr uint32_t smallRecordId = 2;
+    constexpr uint32_t largeRecordId = 3;
+    auto entryGetter = sptr<EntryGetterImpl>::MakeSptr();
+    PasteData pasteData;
+    pasteData.rawDataSize_ = initDataSize;
+
+    std::vector<DelayEntryInfo> delayEntryInfos = {};
+    for (uint32_t i = 0; i <= entryNum; ++i) {
+        auto entry = std::make_shared<PasteDataEntry>();
+        entry->SetUtdId(UTDID_PLAIN_TEXT);
+        delayEntryInfos.push_back({1, i == 0 ? largeRecordId : smallRecordId, entry});
+    }
+
+    DelayManager::GetLocalEntryValue(delayEntryInfos, entryGetter, pasteData);
+    EXPECT_EQ(pasteData.rawDataSize_, initDataSize + entrySize * entryNum);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(delayEntryInfos[0].entry->GetValue()));
+    EXPECT_EQ(delayEntryInfos[entryNum].entry->rawDataSize_, entrySize);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest004 end");
+}
 } // namespace OHOS::MiscServices
@@ -1326,4 +1326,52 @@ HWTEST_F(PasteboardPatternTest, DetectHttpLinkTest015, TestSize.Level1)
     std::set<Pattern> result = PatternDetection::Detect(patternsToCheck, pasteData, false, true);
     ASSERT_EQ(result.count(Pattern::HTTP_URL), 0);
 }
+
+/**
+ * @tc.name: DetectPlainTextTest003
+ * @tc.desc: all patterns are found in one text, and near misses are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardPatternTest, DetectPlainTextTest003, TestSize.Level1)
+{
+    const std::set<Pattern> patternsToCheck = { Pattern::URL, Pattern::NUMBER, Pattern::EMAIL_ADDRESS,
+        Pattern::HTTP_URL, Pattern::FLIGHT_NUMBER };
+    PasteData pasteData;
+    auto record = std::make_shared<PasteDataRecord>();
+    std::string utdId = "utd_004";
+    std::string plainText = "mail a@b.c, see http://x.y or CZ5678";
+    record->AddEntry(utdId, std::make_shared<PasteDataEntry>(utdId, MIMETYPE_TEXT_PLAIN, plainText));
+    pasteData.AddRecord(record);
+    std::set<Pattern> result = PatternDetection::Detect(patternsToCheck, pasteData, false, true);
+    ASSERT_EQ(result, patternsToCheck);
+
+    PasteData missData;
+    auto missRecord = std::make_shared<PasteDataRecord>();
+    std::string missText = "CZ56789 xhttp://a.b";
+    missRecord->AddEntry(utdId, std::make_shared<PasteDataEntry>(utdId, MIMETYPE_TEXT_PLAIN, missText));
+    missData.AddRecord(missRecord);
+    result = PatternDetection::Detect(patternsToCheck, missData, false, true);
+    ASSERT_EQ(result, (std::set<Pattern>{ Pattern::URL, Pattern::NUMBER }));
+}
+
+/**
+ * @tc.name: DetectHtmlTextTest001
+ * @tc.desc: patterns split across tags and chunk boundaries of a large html are detected
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardPatternTest, DetectHtmlTextTest001, TestSize.Level1)
+{
+    constexpr int32_t paragraphNum = 10000;
+    std::string html = "<html><body>";
+    for (int32_t i = 0; i < paragraphNum; ++i) {
+        html += "<p>lorem ipsum <b>dolor</b></p>\n";
+    }
+    html += "<p>flight <b>CZ</b>5678, mail a@b<i>.c</i></p></body></html>";
+    const std::set<Pattern> patternsToCheck = { Pattern::NUMBER, Pattern::EMAIL_ADDRESS, Pattern::HTTP_URL,
+        Pattern::FLIGHT_NUMBER };
+    PasteData pasteData;
+    pasteData.AddRecord(PasteDataRecord::NewHtmlRecord(html));
+    std::set<Pattern> result = PatternDetection::Detect(patternsToCheck, pasteData, true, false);
+    ASSERT_EQ(result, (std::set<Pattern>{ Pattern::NUMBER, Pattern::EMAIL_ADDRESS, Pattern::FLIGHT_NUMBER }));
+}
 } // namespace OHOS::MiscServices
\ No newline at end of file
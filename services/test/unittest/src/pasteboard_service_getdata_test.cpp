@@ -1017,6 +1017,52 @@ HWTEST_F(PasteboardServiceGetDataTest, GetAllPrimaryTextTest005, TestSize.Level1
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetAllPrimaryTextTest005 end");
 }
 
+/**
+ * @tc.name: GetAllPrimaryTextTest006
+ * @tc.desc: text is gathered up to the recognition limit and dropped once it would be exceeded
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceGetDataTest, GetAllPrimaryTextTest006, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetAllPrimaryTextTest006 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    PasteData pasteData;
+    pasteData.AddTextRecord("test");
+    pasteData.AddTextRecord(std::string(MAX_RECOGNITION_LENGTH - 4, 'a'));
+    EXPECT_EQ(tempPasteboard->GetAllPrimaryText(pasteData).size(), MAX_RECOGNITION_LENGTH);
+
+    pasteData.AddTextRecord("b");
+    EXPECT_EQ(tempPasteboard->GetAllPrimaryText(pasteData), "");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetAllPrimaryTextTest006 end");
+}
+
+/**
+ * @tc.name: GetAllEntryPlainTextTest010
+ * @tc.desc: entry text that would exceed the recognition limit is not appended
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceGetDataTest, GetAllEntryPlainTextTest010, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetAllEntryPlainTextTest010 start");
+    uint32_t dataId = 1;
+    uint32_t recordId = 0;
+    std::vector<std::shared_ptr<PasteDataEntry>> tempEntries;
+    std::shared_ptr<PasteDataEntry> entry = std::make_shared<PasteDataEntry>();
+    EXPECT_NE(entry, nullptr);
+    entry->SetMimeType(MIMETYPE_TEXT_PLAIN);
+    entry->SetValue("test");
+    tempEntries.emplace_back(entry);
+    std::string primaryText(MAX_RECOGNITION_LENGTH - 2, 'a');
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+
+    auto ret = tempPasteboard->GetAllEntryPlainText(dataId, recordId, tempEntries, primaryText);
+    EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION));
+    EXPECT_EQ(primaryText.size(), MAX_RECOGNITION_LENGTH - 2);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetAllEntryPlainTextTest010 end");
+}
+
 /**
  * @tc.name: GetRemoteEntryValueTest001
  * @tc.desc: test Func GetRemoteEntryValue
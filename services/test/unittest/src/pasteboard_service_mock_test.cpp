@@ -45,6 +45,9 @@ using namespace OHOS::Storage::DistributedFile;
 namespace OHOS {
 namespace {
     const int32_t INT32_TEN = 10;
+    const int32_t INT32_TWO = 2;
+    const int32_t INT32_THREE = 3;
+    const int32_t INT32_FOUR = 4;
     const int32_t ACCOUNT_IDS_RANDOM = 1121;
     const int INT_ONE = 1;
     const uint8_t UINT8_ONE = 1;
@@ -109,6 +112,30 @@ public:
     }
 };
 
+class FakeEntityRecognizer : public PasteboardEntityRecognizer {
+public:
+    ~FakeEntityRecognizer() override
+    {
+        Stop();
+    }
+    std::atomic<uint32_t> unloadCount = 0;
+
+protected:
+    bool LoadEngine() override
+    {
+        return true;
+    }
+    void UnloadEngine() override
+    {
+        unloadCount++;
+    }
+    int32_t Process(const std::string &text, std::string &entity) override
+    {
+        entity = text;
+        return 0;
+    }
+};
+
 class DistributedFileDaemonManager {
 public:
     DistributedFileDaemonManager() {}
@@ -333,6 +360,15 @@ std::shared_ptr<PasteDataRecord> PasteData::GetRecordById(uint32_t recordId) con
     return interface->GetRecordById(recordId);
 }
 
+std::shared_ptr<PasteDataRecord> PasteData::PeekRecordById(uint32_t recordId) const
+{
+    PasteboardServiceInterface *interface = GetPasteboardServiceInterface();
+    if (interface == nullptr) {
+        return nullptr;
+    }
+    return interface->GetRecordById(recordId);
+}
+
 bool PasteDataEntry::HasContent(const std::string &utdId) const
 {
     PasteboardServiceInterface *interface = GetPasteboardServiceInterface();
@@ -441,6 +477,15 @@ std::vector<std::shared_ptr<PasteDataRecord>> PasteData::AllRecords() const
     }
     return interface->AllRecords();
 }
+
+std::vector<std::shared_ptr<PasteDataRecord>> PasteData::PeekRecords() const
+{
+    PasteboardServiceInterface *interface = GetPasteboardServiceInterface();
+    if (interface == nullptr) {
+        return std::vector<std::shared_ptr<PasteDataRecord>>();
+    }
+    return interface->AllRecords();
+}
 }
 
 bool OHOS::system::GetBoolParameter(const std::string &key, bool defaultValue)
@@ -844,6 +889,42 @@ HWTEST_F(PasteboardServiceMockTest, GetRecordValueByTypeTest011, TestSize.Level1
     EXPECT_EQ(result, static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR));
 }
 
+/**
+ * @tc.name: GetRecordValueByTypeTest012
+ * @tc.desc: filling a delayed entry keeps the type index of the stored clip
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, GetRecordValueByTypeTest012, TestSize.Level1)
+{
+    PasteboardService service;
+    uint32_t recordId = 0;
+    PasteDataEntry value;
+    value.SetUtdId(RANDOM_STRING);
+    service.currentUserId_.store(ACCOUNT_IDS_RANDOM);
+    auto data = std::make_shared<PasteData>();
+    auto record = PasteDataRecord::NewPlainTextRecord(RANDOM_STRING);
+    auto entry = std::make_shared<PasteDataEntry>();
+    data->SetDataId(service.delayDataId_);
+    data->AddRecord(record);
+    data->SetRemote(false);
+    data->BuildTypeIndex();
+    entry->SetMimeType(MIMETYPE_TEXT_PLAIN);
+    entry->SetValue(RANDOM_STRING);
+    ASSERT_NE(data->GetTypeIndex(), nullptr);
+
+    service.clips_.InsertOrAssign(ACCOUNT_IDS_RANDOM, data);
+    NiceMock<PasteboardServiceInterfaceMock> mock;
+    EXPECT_CALL(mock, GetTokenTypeFlag).WillRepeatedly(Return(ATokenTypeEnum::TOKEN_NATIVE));
+    EXPECT_CALL(mock, GetCallingTokenID()).WillOnce(Return(service.delayTokenId_.load()));
+    EXPECT_CALL(mock, HasContent(testing::_)).WillOnce(Return(true));
+    EXPECT_CALL(mock, GetRecordById(testing::_)).WillOnce(Return(record));
+    EXPECT_CALL(mock, GetEntry(testing::_)).WillOnce(Return(entry)).WillOnce(Return(entry));
+
+    int32_t result = service.GetRecordValueByType(service.delayDataId_, recordId, value);
+    EXPECT_EQ(result, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_NE(data->GetTypeIndex(), nullptr);
+}
+
 /**
  * @tc.name: ShowProgressTest001
  * @tc.desc: test Func ShowProgress HasPasteData return false
@@ -1684,6 +1765,523 @@ HWTEST_F(PasteboardServiceMockTest, DumpDataTest005, TestSize.Level1)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpDataTest005 end.");
 }
 
+/**
+ * @tc.name: DumpLockStatsTest001
+ * @tc.desc: DumpLockStats without foreground user
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, DumpLockStatsTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpLockStatsTest001 start.");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    NiceMock<PasteboardServiceInterfaceMock> mock;
+    tempPasteboard->currentUserId_.store(ERROR_USERID);
+    EXPECT_CALL(mock, QueryActiveOsAccountIds(testing::_)).WillRepeatedly(Return(INT_ONE));
+    auto ret = tempPasteboard->DumpLockStats();
+    ASSERT_EQ(ret, "Lock stats fail! no foreground user.");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpLockStatsTest001 end.");
+}
+
+/**
+ * @tc.name: DumpSetStatsTest001
+ * @tc.desc: DumpSetStats of an idle pipeline
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, DumpSetStatsTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpSetStatsTest001 start.");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    auto ret = tempPasteboard->DumpSetStats();
+    ASSERT_EQ(ret, "|Queue depth :  0\n|Max depth   :  0\n|Completed   :  0\n|Superseded  :  0\n|Rejected    :  0\n");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpSetStatsTest001 end.");
+}
+
+/**
+ * @tc.name: DumpNotifyStatsTest001
+ * @tc.desc: DumpNotifyStats of an idle executor
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, DumpNotifyStatsTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpNotifyStatsTest001 start.");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    auto ret = tempPasteboard->DumpNotifyStats();
+    ASSERT_EQ(ret, "|Pending     :  0\n|Dispatched  :  0\n|Avg latency :  0ms\n|Max latency :  0ms\n"
+        "|Coalesced   :  0\n|Dropped     :  0\n|Timeouts    :  0\n");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpNotifyStatsTest001 end.");
+}
+
+/**
+ * @tc.name: DumpTimerStatsTest001
+ * @tc.desc: DumpTimerStats before the timer is created
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, DumpTimerStatsTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpTimerStatsTest001 start.");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    auto ret = tempPasteboard->DumpTimerStats();
+    ASSERT_EQ(ret, "Timer stats fail! timer is null.");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpTimerStatsTest001 end.");
+}
+
+/**
+ * @tc.name: DumpVersionStatsTest001
+ * @tc.desc: DumpVersionStats pads every label to the longest one
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, DumpVersionStatsTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpVersionStatsTest001 start.");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    auto ret = tempPasteboard->DumpVersionStats();
+    EXPECT_EQ(ret.find("|Table hits      :  0\n"), 0U);
+    EXPECT_NE(ret.find("\n|Profile hit rate:  "), std::string::npos);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpVersionStatsTest001 end.");
+}
+
+/**
+ * @tc.name: DumpPatternStatsTest001
+ * @tc.desc: DumpPatternStats before any detection
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, DumpPatternStatsTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpPatternStatsTest001 start.");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    auto ret = tempPasteboard->DumpPatternStats();
+    ASSERT_EQ(ret, "|Hits        :  0\n|Misses      :  0\n|Hit rate    :  -\n");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpPatternStatsTest001 end.");
+}
+
+/**
+ * @tc.name: PasteboardUserLockTest001
+ * @tc.desc: waiting for a user lock is counted, other users are not blocked
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardUserLockTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardUserLockTest001 start.");
+    uint64_t contention = PasteboardUserLock::GetContention(ACCOUNT_IDS_RANDOM);
+    uint64_t otherContention = PasteboardUserLock::GetContention(ACCOUNT_IDS_RANDOM + 1);
+    auto write = PasteboardUserLock::Write(ACCOUNT_IDS_RANDOM);
+    {
+        auto read = PasteboardUserLock::Read(ACCOUNT_IDS_RANDOM + 1);
+        EXPECT_TRUE(read.owns_lock());
+    }
+    std::thread reader([]() {
+        auto read = PasteboardUserLock::Read(ACCOUNT_IDS_RANDOM);
+        EXPECT_TRUE(read.owns_lock());
+    });
+    while (PasteboardUserLock::GetContention(ACCOUNT_IDS_RANDOM) == contention) {
+        std::this_thread::yield();
+    }
+    write.unlock();
+    reader.join();
+    EXPECT_EQ(PasteboardUserLock::GetContention(ACCOUNT_IDS_RANDOM), contention + 1);
+    EXPECT_EQ(PasteboardUserLock::GetContention(ACCOUNT_IDS_RANDOM + 1), otherContention);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardUserLockTest001 end.");
+}
+
+/**
+ * @tc.name: PasteboardSetPipelineTest001
+ * @tc.desc: a queued set task is superseded by a later one of the same user and gets its result
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardSetPipelineTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardSetPipelineTest001 start.");
+    PasteboardSetPipeline pipeline(INT32_TEN);
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    std::atomic<int32_t> executed = 0;
+    std::thread running([&]() {
+        bool superseded = true;
+        pipeline.Submit(ACCOUNT_IDS_RANDOM, [&]() {
+            started = true;
+            while (!released) {
+                std::this_thread::yield();
+            }
+            return static_cast<int32_t>(PasteboardError::E_OK);
+        }, superseded);
+        EXPECT_FALSE(superseded);
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    int32_t queuedRet = INT32_NEGATIVE_NUMBER;
+    bool queuedSuperseded = false;
+    std::thread queued([&]() {
+        queuedRet = pipeline.Submit(ACCOUNT_IDS_RANDOM, [&]() {
+            executed++;
+            return static_cast<int32_t>(PasteboardError::E_OK);
+        }, queuedSuperseded);
+    });
+    while (pipeline.GetStats().depth != 1) {
+        std::this_thread::yield();
+    }
+    int32_t latestRet = INT32_NEGATIVE_NUMBER;
+    bool latestSuperseded = true;
+    std::thread latest([&]() {
+        latestRet = pipeline.Submit(ACCOUNT_IDS_RANDOM, [&]() {
+            executed++;
+            return static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR);
+        }, latestSuperseded);
+    });
+    while (pipeline.GetStats().superseded != 1) {
+        std::this_thread::yield();
+    }
+    released = true;
+    running.join();
+    queued.join();
+    latest.join();
+    EXPECT_TRUE(queuedSuperseded);
+    EXPECT_FALSE(latestSuperseded);
+    EXPECT_EQ(queuedRet, static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR));
+    EXPECT_EQ(latestRet, static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR));
+    EXPECT_EQ(executed.load(), 1);
+    auto stats = pipeline.GetStats();
+    EXPECT_EQ(stats.depth, 0);
+    EXPECT_EQ(stats.maxDepth, 2);
+    EXPECT_EQ(stats.completed, 2);
+    EXPECT_EQ(stats.rejected, 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardSetPipelineTest001 end.");
+}
+
+/**
+ * @tc.name: PasteboardSetPipelineTest002
+ * @tc.desc: a running set task of one user does not hold back the tasks of another user
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardSetPipelineTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardSetPipelineTest002 start.");
+    PasteboardSetPipeline pipeline(INT32_TEN);
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    std::thread running([&]() {
+        bool superseded = true;
+        pipeline.Submit(ACCOUNT_IDS_RANDOM, [&]() {
+            started = true;
+            while (!released) {
+                std::this_thread::yield();
+            }
+            return static_cast<int32_t>(PasteboardError::E_OK);
+        }, superseded);
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    bool superseded = true;
+    int32_t ret = pipeline.Submit(ACCOUNT_IDS_RANDOM + 1, []() {
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }, superseded);
+    EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_FALSE(superseded);
+    EXPECT_FALSE(released.load());
+    released = true;
+    running.join();
+    EXPECT_EQ(pipeline.GetStats().completed, 2);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardSetPipelineTest002 end.");
+}
+
+/**
+ * @tc.name: PasteboardNotifyExecutorTest001
+ * @tc.desc: a blocked observer does not delay others, repeated events are coalesced and dropped after timeout
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardNotifyExecutorTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardNotifyExecutorTest001 start.");
+    constexpr uint64_t timeoutMs = 10;
+    PasteboardNotifyExecutor executor(INT32_TWO, INT32_TEN, timeoutMs);
+    sptr<RefBase> slowObserver = new RefBase();
+    sptr<RefBase> fastObserver = new RefBase();
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    std::atomic<int32_t> slowCalls = 0;
+    std::atomic<int32_t> fastCalls = 0;
+    executor.Post(slowObserver, "changed", [&]() {
+        started = true;
+        while (!released) {
+            std::this_thread::yield();
+        }
+        slowCalls++;
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    executor.Post(slowObserver, "changed", [&]() { slowCalls++; });
+    executor.Post(slowObserver, "changed", [&]() { slowCalls++; });
+    executor.Post(fastObserver, "changed", [&]() { fastCalls++; });
+    while (fastCalls.load() != 1) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(executor.GetStats().coalesced, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs * INT32_TWO));
+    executor.Post(slowObserver, "event", [&]() { slowCalls++; });
+    released = true;
+    while (executor.GetStats().dispatched != INT32_TWO) {
+        std::this_thread::yield();
+    }
+    auto stats = executor.GetStats();
+    EXPECT_EQ(slowCalls.load(), 1);
+    EXPECT_EQ(stats.pending, 0);
+    EXPECT_EQ(stats.timeouts, 1);
+    EXPECT_EQ(stats.dropped, INT32_TWO);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardNotifyExecutorTest001 end.");
+}
+
+/**
+ * @tc.name: PasteboardNotifyExecutorTest002
+ * @tc.desc: only a repeat of the last queued event is coalesced, so events keep their order
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardNotifyExecutorTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardNotifyExecutorTest002 start.");
+    constexpr uint64_t timeoutMs = 1000;
+    PasteboardNotifyExecutor executor(INT_ONE, INT32_TEN, timeoutMs);
+    sptr<RefBase> observer = new RefBase();
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    std::mutex mutex;
+    std::vector<std::string> delivered;
+    auto deliver = [&](const std::string &event) {
+        return [&, event]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            delivered.push_back(event);
+        };
+    };
+    executor.Post(observer, "block", [&]() {
+        started = true;
+        while (!released) {
+            std::this_thread::yield();
+        }
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    executor.Post(observer, "write", deliver("write"));
+    executor.Post(observer, "read", deliver("read"));
+    executor.Post(observer, "write", deliver("write"));
+    executor.Post(observer, "write", deliver("write"));
+    released = true;
+    while (executor.GetStats().dispatched != INT32_FOUR) {
+        std::this_thread::yield();
+    }
+    std::vector<std::string> expected = { "write", "read", "write" };
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(delivered, expected);
+    EXPECT_EQ(executor.GetStats().coalesced, 1);
+    EXPECT_TRUE(executor.queues_.empty());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardNotifyExecutorTest002 end.");
+}
+
+/**
+ * @tc.name: PasteboardUriGrantLedgerTest001
+ * @tc.desc: granted uris are skipped for the same clip and target, and forgotten in bulk
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardUriGrantLedgerTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardUriGrantLedgerTest001 start.");
+    constexpr uint32_t dataId = 1;
+    constexpr uint32_t targetToken = 100;
+    constexpr pid_t targetPid = 200;
+    PasteboardUriGrantLedger ledger;
+    PasteboardUriGrantLedger::Target target{ targetToken, targetPid, PasteDataRecord::READ_PERMISSION, false };
+    std::vector<Uri> uris = { Uri("file://a/1"), Uri("file://a/2") };
+    ledger.Record(ACCOUNT_IDS_RANDOM, dataId, target, { uris[0] });
+    auto pending = ledger.FilterGranted(ACCOUNT_IDS_RANDOM, dataId, target, uris);
+    ASSERT_EQ(pending.size(), 1);
+    EXPECT_EQ(pending[0].ToString(), "file://a/2");
+    EXPECT_EQ(ledger.FilterGranted(ACCOUNT_IDS_RANDOM, dataId + 1, target, uris).size(), uris.size());
+    auto otherPid = target;
+    otherPid.pid = targetPid + 1;
+    EXPECT_EQ(ledger.FilterGranted(ACCOUNT_IDS_RANDOM, dataId, otherPid, uris).size(), uris.size());
+
+    ledger.Record(ACCOUNT_IDS_RANDOM, dataId, target, uris);
+    EXPECT_EQ(ledger.GetGrantedCount(ACCOUNT_IDS_RANDOM), uris.size());
+    EXPECT_TRUE(ledger.FilterGranted(ACCOUNT_IDS_RANDOM, dataId, target, uris).empty());
+    ledger.ForgetPid(targetPid);
+    EXPECT_EQ(ledger.GetGrantedCount(ACCOUNT_IDS_RANDOM), 0);
+    ledger.Record(ACCOUNT_IDS_RANDOM, dataId, target, uris);
+    ledger.ForgetToken(targetToken);
+    EXPECT_EQ(ledger.GetGrantedCount(ACCOUNT_IDS_RANDOM), 0);
+    ledger.Record(ACCOUNT_IDS_RANDOM, dataId, target, uris);
+    ledger.Forget(ACCOUNT_IDS_RANDOM);
+    EXPECT_EQ(ledger.FilterGranted(ACCOUNT_IDS_RANDOM, dataId, target, uris).size(), uris.size());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardUriGrantLedgerTest001 end.");
+}
+
+/**
+ * @tc.name: PasteboardUriGrantLedgerTest002
+ * @tc.desc: GrantPermission looks up the ledger with the dataId of the granted clip, not the local clip
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardUriGrantLedgerTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardUriGrantLedgerTest002 start.");
+    constexpr uint32_t remoteDataId = 1;
+    constexpr uint32_t targetToken = 100;
+    constexpr pid_t targetPid = 200;
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    testing::NiceMock<PasteboardServiceInterfaceMock> mock;
+    EXPECT_CALL(mock, GetTokenTypeFlag).WillRepeatedly(Return(ATokenTypeEnum::TOKEN_INVALID));
+    EXPECT_CALL(mock, GetCallingTokenID).WillRepeatedly(Return(targetToken));
+    EXPECT_CALL(mock, GetCallingPid).WillRepeatedly(Return(targetPid));
+    int32_t userId = tempPasteboard->GetAppInfo(targetToken).userId;
+
+    auto localData = std::make_shared<PasteData>();
+    localData->SetDataId(remoteDataId + 1);
+    tempPasteboard->clips_.InsertOrAssign(userId, localData);
+    std::vector<Uri> uris = { Uri("file://a/1") };
+    PasteboardUriGrantLedger::Target target{ targetToken, targetPid, PasteDataRecord::READ_PERMISSION, true };
+    tempPasteboard->uriGrantLedger_.Record(userId, remoteDataId, target, uris);
+
+    auto ret = tempPasteboard->GrantPermission(uris, PasteDataRecord::READ_PERMISSION, true, targetToken,
+        remoteDataId);
+    EXPECT_EQ(ret, 0);
+    EXPECT_EQ(tempPasteboard->readBundles_.count(targetToken), 0);
+    EXPECT_EQ(tempPasteboard->uriGrantLedger_.GetGrantedCount(userId), uris.size());
+    tempPasteboard->clips_.Clear();
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardUriGrantLedgerTest002 end.");
+}
+
+/**
+ * @tc.name: PasteboardPatternCacheTest001
+ * @tc.desc: checked patterns are answered from the cache until the clip changes
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardPatternCacheTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardPatternCacheTest001 start.");
+    constexpr uint32_t dataId = 1;
+    PasteboardPatternCache cache;
+    std::set<Pattern> result;
+    const std::set<Pattern> checked = { Pattern::URL, Pattern::NUMBER };
+    EXPECT_FALSE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, false, true, checked, result));
+    cache.Store(ACCOUNT_IDS_RANDOM, dataId, false, true, cache.GetGeneration(ACCOUNT_IDS_RANDOM), checked,
+        { Pattern::NUMBER });
+
+    EXPECT_TRUE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, false, true, { Pattern::NUMBER }, result));
+    EXPECT_EQ(result, std::set<Pattern>{ Pattern::NUMBER });
+    EXPECT_TRUE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, false, true, { Pattern::URL }, result));
+    EXPECT_TRUE(result.empty());
+    EXPECT_FALSE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, false, true, { Pattern::EMAIL_ADDRESS }, result));
+    EXPECT_FALSE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, true, true, checked, result));
+    EXPECT_FALSE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId + 1, false, true, checked, result));
+
+    uint64_t staleGeneration = cache.GetGeneration(ACCOUNT_IDS_RANDOM);
+    cache.Invalidate(ACCOUNT_IDS_RANDOM + 1);
+    EXPECT_TRUE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, false, true, checked, result));
+    cache.Invalidate(ACCOUNT_IDS_RANDOM);
+    EXPECT_FALSE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, false, true, checked, result));
+    cache.Store(ACCOUNT_IDS_RANDOM, dataId, false, true, staleGeneration, checked, { Pattern::NUMBER });
+    EXPECT_FALSE(cache.Lookup(ACCOUNT_IDS_RANDOM, dataId, false, true, checked, result));
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, INT32_THREE);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardPatternCacheTest001 end.");
+}
+
+/**
+ * @tc.name: PasteboardEntityRecognizerTest001
+ * @tc.desc: rapid submissions are coalesced and the engine is unloaded once observers are gone
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardEntityRecognizerTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardEntityRecognizerTest001 start.");
+    FakeEntityRecognizer recognizer;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> results;
+    recognizer.SetResultCallback([&mutex, &cv, &results](const std::string &text, const std::string &entity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(entity);
+        cv.notify_all();
+    });
+    std::atomic<bool> hasObserver = false;
+    recognizer.SetObserverQuery([&hasObserver]() { return hasObserver.load(); });
+    recognizer.Submit("no observer");
+    hasObserver = true;
+    recognizer.Submit("first");
+    recognizer.Submit("second");
+    recognizer.Submit("third");
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, seconds(INT32_THREE), [&results] { return results.size() == 1; }));
+    }
+    recognizer.Submit("fourth");
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, seconds(INT32_THREE), [&results] { return results.size() == INT32_TWO; }));
+        EXPECT_EQ(results, (std::vector<std::string>{ "third", "fourth" }));
+    }
+    hasObserver = false;
+    recognizer.NotifyObserverChanged();
+    auto deadline = steady_clock::now() + seconds(INT32_THREE);
+    while (recognizer.unloadCount.load() == 0 && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(INT32_TEN));
+    }
+    EXPECT_EQ(recognizer.unloadCount.load(), 1);
+    auto stats = recognizer.GetStats();
+    EXPECT_EQ(stats.submitted, INT32_FOUR);
+    EXPECT_EQ(stats.processed, INT32_TWO);
+    EXPECT_EQ(stats.engineLoads, 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardEntityRecognizerTest001 end.");
+}
+
+/**
+ * @tc.name: PasteboardRemoteEventCacheTest001
+ * @tc.desc: validated events and remote mime types are kept until a peer goes offline
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceMockTest, PasteboardRemoteEventCacheTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardRemoteEventCacheTest001 start.");
+    using Stage = PasteboardRemoteEventCache::Stage;
+    PasteboardRemoteEventCache cache;
+    TestEvent event;
+    event.deviceId = RANDOM_STRING;
+    event.seqId = 1;
+    event.dataId = 1;
+    Stage stage = Stage::NO_EVENT;
+    TestEvent cachedEvent;
+    EXPECT_FALSE(cache.GetEvent(ACCOUNT_IDS_RANDOM, stage, cachedEvent));
+    cache.StoreEvent(ACCOUNT_IDS_RANDOM, cache.GetGeneration(), Stage::REMOTE_EVENT, event);
+    EXPECT_TRUE(cache.GetEvent(ACCOUNT_IDS_RANDOM, stage, cachedEvent));
+    EXPECT_EQ(stage, Stage::REMOTE_EVENT);
+    EXPECT_EQ(cachedEvent.deviceId, RANDOM_STRING);
+
+    PasteboardRemoteEventCache::RemoteTypes types;
+    types.mimeTypes = { MIMETYPE_TEXT_PLAIN };
+    cache.StoreTypes(cache.GetGeneration(), event, types);
+    PasteboardRemoteEventCache::RemoteTypes cachedTypes;
+    EXPECT_TRUE(cache.GetTypes(event, cachedTypes));
+    EXPECT_EQ(cachedTypes.mimeTypes, std::vector<std::string>{ MIMETYPE_TEXT_PLAIN });
+    EXPECT_FALSE(cachedTypes.hasUtdTypes);
+    TestEvent newEvent = event;
+    newEvent.seqId++;
+    EXPECT_FALSE(cache.GetTypes(newEvent, cachedTypes));
+
+    uint64_t staleGeneration = cache.GetGeneration();
+    cache.Offline(RANDOM_STRING);
+    EXPECT_FALSE(cache.GetEvent(ACCOUNT_IDS_RANDOM, stage, cachedEvent));
+    EXPECT_FALSE(cache.GetTypes(event, cachedTypes));
+    cache.StoreEvent(ACCOUNT_IDS_RANDOM, staleGeneration, Stage::REMOTE_EVENT, event);
+    EXPECT_FALSE(cache.GetEvent(ACCOUNT_IDS_RANDOM, stage, cachedEvent));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardRemoteEventCacheTest001 end.");
+}
+
 /**
  * @tc.name: IsCallerUidValid001
  * @tc.desc: IsCallerUidValid001 function test
@@ -3449,7 +4047,7 @@ HWTEST_F(PasteboardServiceMockTest, GrantUriPermissionTest001, TestSize.Level1)
     std::map<uint32_t, std::vector<Uri>> uriMap;
     uriMap.insert(std::make_pair(PasteDataRecord::READ_PERMISSION, grantUris));
 
-    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, false);
+    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, false, 0);
     EXPECT_NE(result, static_cast<int32_t>(PasteboardError::E_OK));
 }
 
@@ -3473,7 +4071,7 @@ HWTEST_F(PasteboardServiceMockTest, GrantUriPermissionTest002, TestSize.Level1)
     std::map<uint32_t, std::vector<Uri>> uriMap;
     uriMap.insert(std::make_pair(PasteDataRecord::READ_PERMISSION, grantUris));
 
-    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, false);
+    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, false, 0);
     EXPECT_NE(result, static_cast<int32_t>(PasteboardError::E_OK));
 }
 
@@ -3497,7 +4095,7 @@ HWTEST_F(PasteboardServiceMockTest, GrantUriPermissionTest003, TestSize.Level1)
     std::map<uint32_t, std::vector<Uri>> uriMap;
     uriMap.insert(std::make_pair(PasteDataRecord::READ_PERMISSION, grantUris));
 
-    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, true);
+    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, true, 0);
     EXPECT_NE(result, static_cast<int32_t>(PasteboardError::E_OK));
 }
 
@@ -3521,7 +4119,7 @@ HWTEST_F(PasteboardServiceMockTest, GrantUriPermissionTest004, TestSize.Level1)
     std::map<uint32_t, std::vector<Uri>> uriMap;
     uriMap.insert(std::make_pair(PasteDataRecord::READ_PERMISSION, grantUris));
 
-    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, true);
+    auto result = tempPasteboard->GrantUriPermission(uriMap, targetTokenId, true, 0);
     EXPECT_NE(result, static_cast<int32_t>(PasteboardError::E_OK));
 }
 
@@ -17,6 +17,7 @@
 #include <thread>
 #include <unistd.h>
 
+#include "clip_plugin_fake.h"
 #include "ipc_skeleton.h"
 #include "message_parcel_warp.h"
 #include "pasteboard_error.h"
@@ -25,6 +26,7 @@
 #include "pasteboard_service.h"
 #include "pasteboard_time.h"
 #include "paste_data_entry.h"
+#include "tlv_chunk.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -42,6 +44,8 @@ const int INT_THREETHREETHREE = 333;
 const uint32_t MAX_RECOGNITION_LENGTH = 1000;
 constexpr int64_t MIN_ASHMEM_DATA_SIZE = 32 * 1024;
 constexpr uint32_t EVENT_TIME_OUT = 2000;
+constexpr int64_t MAX_CHUNK_RETRY_TIME = 1000; // milliseconds, the retry budget of one chunked paste
+constexpr size_t TEXT_SIZE_LARGE = 4096;
 const int32_t ACCOUNT_IDS_RANDOM = 1121;
 const uint32_t UINT32_ONE = 1;
 const std::string TEST_ENTITY_TEXT =
@@ -445,5 +449,233 @@ HWTEST_F(PasteboardServiceRemoteTest, ProcessRemoteDelayUriTest001, TestSize.Lev
     EXPECT_NE(ret, static_cast<int32_t>(PasteboardError::E_OK));
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "ProcessRemoteDelayUriTest001 end");
 }
+
+/**
+ * @tc.name: PasteboardTypeFrameTest001
+ * @tc.desc: remote type queries are answered from the type frame without pulling the payload
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, PasteboardTypeFrameTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardTypeFrameTest001 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    PasteData data;
+    data.AddTextRecord(TEST_ENTITY_TEXT_CN_5);
+    data.AddHtmlRecord(TEST_ENTITY_TEXT_CN_5);
+    auto frame = tempPasteboard->EncodeTypeFrame(data);
+    ASSERT_TRUE(ClipPlugin::IsTypeFrame(frame));
+    EXPECT_TRUE(tempPasteboard->DecodeMimeTypes(frame).empty());
+    PasteDataTypeIndex typeIndex;
+    ASSERT_TRUE(tempPasteboard->DecodeTypeFrame(frame, typeIndex));
+    EXPECT_EQ(typeIndex.recordSizes.size(), data.GetRecordCount());
+
+    auto clipPlugin = std::make_shared<ClipPluginFake>();
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    event.deviceId = "deviceId";
+    event.dataType = data.GetMimeTypes();
+    clipPlugin->SetPasteData(event, {}, DistributedModuleConfig::Version::VERSION_SEVEN, frame);
+    auto events = clipPlugin->GetTopEvents(1, ACCOUNT_IDS_RANDOM);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].version, ClipPlugin::InfoType::TYPE_INDEX);
+
+    tempPasteboard->clipPlugin_ = clipPlugin;
+    bool hasType = false;
+    auto htmlUtd = CommonUtils::Convert2UtdId(UDMF::UD_BUTT, MIMETYPE_TEXT_HTML);
+    EXPECT_TRUE(tempPasteboard->HasRemoteUtdType(htmlUtd, events[0], hasType));
+    EXPECT_TRUE(hasType);
+    std::vector<std::string> mimeTypes;
+    EXPECT_EQ(tempPasteboard->GetRemoteMimeTypes(mimeTypes, events[0]), ERR_OK);
+    EXPECT_EQ(mimeTypes, data.GetMimeTypes());
+    EXPECT_EQ(clipPlugin->GetPasteDataCount(), 0);
+
+    events[0].version = ClipPlugin::InfoType::DEFAULT;
+    events[0].dataType = { MIMETYPE_TEXT_PLAIN };
+    EXPECT_TRUE(tempPasteboard->HasRemoteUtdType(htmlUtd, events[0], hasType));
+    EXPECT_FALSE(hasType);
+    tempPasteboard->clipPlugin_ = nullptr;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardTypeFrameTest001 end");
+}
+
+/**
+ * @tc.name: PasteboardTypeFrameTest002
+ * @tc.desc: peers before VERSION_SEVEN get the mimeTypes list, and small clips carry no types at all
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, PasteboardTypeFrameTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardTypeFrameTest002 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    PasteData data;
+    data.AddTextRecord(std::string(TEXT_SIZE_LARGE, 'a'));
+    data.AddHtmlRecord(TEST_ENTITY_TEXT_CN_5);
+    std::vector<uint8_t> rawData;
+    ASSERT_TRUE(data.Encode(rawData));
+
+    auto payload = tempPasteboard->EncodeRemoteMimeTypes(data, rawData.size(),
+        DistributedModuleConfig::Version::VERSION_SIX);
+    EXPECT_FALSE(ClipPlugin::IsTypeFrame(payload));
+    EXPECT_EQ(tempPasteboard->DecodeMimeTypes(payload), data.GetMimeTypes());
+
+    payload = tempPasteboard->EncodeRemoteMimeTypes(data, rawData.size(),
+        DistributedModuleConfig::Version::VERSION_SEVEN);
+    EXPECT_TRUE(ClipPlugin::IsTypeFrame(payload));
+
+    PasteData small;
+    small.AddTextRecord(TEST_ENTITY_TEXT_CN_5);
+    std::vector<uint8_t> smallData;
+    ASSERT_TRUE(small.Encode(smallData));
+    EXPECT_TRUE(tempPasteboard->EncodeRemoteMimeTypes(small, smallData.size(),
+        DistributedModuleConfig::Version::VERSION_SEVEN).empty());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardTypeFrameTest002 end");
+}
+
+/**
+ * @tc.name: PasteboardChunkTransferTest001
+ * @tc.desc: a clip above one chunk is pulled frame by frame from the chunk source of the sender
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, PasteboardChunkTransferTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardChunkTransferTest001 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    PasteData data;
+    std::string text(TLVChunkWriter::CHUNK_SIZE * 2, 'a');
+    data.AddTextRecord(text);
+    std::vector<uint8_t> rawData;
+    ASSERT_TRUE(data.Encode(rawData));
+    ASSERT_GT(rawData.size(), TLVChunkWriter::CHUNK_SIZE);
+
+    auto clipPlugin = std::make_shared<ClipPluginFake>();
+    tempPasteboard->clipPlugin_ = clipPlugin;
+    clipPlugin->RegisterDelayCallback(nullptr, std::bind(&PasteboardService::GetDistributedDelayEntry,
+        tempPasteboard.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4));
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    event.deviceId = "deviceId";
+    auto writer = std::make_shared<TLVChunkWriter>(std::move(rawData));
+    tempPasteboard->SetDistributedChunkSource(event, writer);
+    std::vector<uint8_t> firstFrame;
+    ASSERT_TRUE(writer->GetChunk(0, firstFrame));
+    ASSERT_EQ(clipPlugin->SetPasteData(event, firstFrame, DistributedModuleConfig::Version::VERSION_SEVEN, {}), 0);
+
+    auto [pasteData, result] = tempPasteboard->GetDistributedData(event, ACCOUNT_IDS_RANDOM);
+    ASSERT_NE(pasteData, nullptr);
+    EXPECT_EQ(result.errorCode, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(pasteData->rawDataSize_, static_cast<int64_t>(writer->GetData().size()));
+    ASSERT_NE(pasteData->GetPrimaryText(), nullptr);
+    EXPECT_EQ(*pasteData->GetPrimaryText(), text);
+    EXPECT_EQ(clipPlugin->GetPasteDataCount(), 1);
+
+    tempPasteboard->maxLocalCapacity_.store(TLVChunkWriter::CHUNK_SIZE);
+    auto [tooLarge, tooLargeResult] = tempPasteboard->GetDistributedData(event, ACCOUNT_IDS_RANDOM);
+    EXPECT_EQ(tooLarge, nullptr);
+    EXPECT_EQ(tooLargeResult.errorCode, static_cast<int32_t>(PasteboardError::REMOTE_DATA_SIZE_EXCEEDED));
+    tempPasteboard->clipPlugin_ = nullptr;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardChunkTransferTest001 end");
+}
+
+/**
+ * @tc.name: PasteboardChunkTransferTest002
+ * @tc.desc: a corrupt first frame is pulled again as a chunk entry, a missing chunk source fails after the retries
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, PasteboardChunkTransferTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardChunkTransferTest002 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    PasteData data;
+    std::string text(TLVChunkWriter::CHUNK_SIZE * 2, 'a');
+    data.AddTextRecord(text);
+    std::vector<uint8_t> rawData;
+    ASSERT_TRUE(data.Encode(rawData));
+
+    auto clipPlugin = std::make_shared<ClipPluginFake>();
+    tempPasteboard->clipPlugin_ = clipPlugin;
+    clipPlugin->RegisterDelayCallback(nullptr, std::bind(&PasteboardService::GetDistributedDelayEntry,
+        tempPasteboard.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4));
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    event.deviceId = "deviceId";
+    auto writer = std::make_shared<TLVChunkWriter>(std::move(rawData));
+    tempPasteboard->SetDistributedChunkSource(event, writer);
+    std::vector<uint8_t> firstFrame;
+    ASSERT_TRUE(writer->GetChunk(0, firstFrame));
+    firstFrame.back() ^= 0xFF;
+    ASSERT_EQ(clipPlugin->SetPasteData(event, firstFrame, DistributedModuleConfig::Version::VERSION_SEVEN, {}), 0);
+
+    auto [pasteData, result] = tempPasteboard->GetDistributedData(event, ACCOUNT_IDS_RANDOM);
+    ASSERT_NE(pasteData, nullptr);
+    EXPECT_EQ(result.errorCode, static_cast<int32_t>(PasteboardError::E_OK));
+    ASSERT_NE(pasteData->GetPrimaryText(), nullptr);
+    EXPECT_EQ(*pasteData->GetPrimaryText(), text);
+
+    tempPasteboard->SetDistributedChunkSource(event, nullptr);
+    auto [lost, lostResult] = tempPasteboard->GetDistributedData(event, ACCOUNT_IDS_RANDOM);
+    EXPECT_EQ(lost, nullptr);
+    EXPECT_EQ(lostResult.errorCode, static_cast<int32_t>(PasteboardError::REMOTE_TASK_ERROR));
+    tempPasteboard->clipPlugin_ = nullptr;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardChunkTransferTest002 end");
+}
+
+/**
+ * @tc.name: PasteboardChunkTransferTest003
+ * @tc.desc: a chunked paste that loses the link keeps its checked frames, the next paste resumes after them
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, PasteboardChunkTransferTest003, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardChunkTransferTest003 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    PasteData data;
+    std::string text(TLVChunkWriter::CHUNK_SIZE * 2, 'a');
+    data.AddTextRecord(text);
+    std::vector<uint8_t> rawData;
+    ASSERT_TRUE(data.Encode(rawData));
+
+    auto clipPlugin = std::make_shared<ClipPluginFake>();
+    tempPasteboard->clipPlugin_ = clipPlugin;
+    clipPlugin->RegisterDelayCallback(nullptr, std::bind(&PasteboardService::GetDistributedDelayEntry,
+        tempPasteboard.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4));
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    event.deviceId = "deviceId";
+    auto writer = std::make_shared<TLVChunkWriter>(std::move(rawData));
+    std::vector<uint8_t> firstFrame;
+    ASSERT_TRUE(writer->GetChunk(0, firstFrame));
+    ASSERT_EQ(clipPlugin->SetPasteData(event, firstFrame, DistributedModuleConfig::Version::VERSION_SEVEN, {}), 0);
+
+    auto begin = std::chrono::steady_clock::now();
+    auto [lost, lostResult] = tempPasteboard->GetDistributedData(event, ACCOUNT_IDS_RANDOM);
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    EXPECT_EQ(lost, nullptr);
+    EXPECT_EQ(lostResult.errorCode, static_cast<int32_t>(PasteboardError::REMOTE_TASK_ERROR));
+    EXPECT_LE(cost.count(), MAX_CHUNK_RETRY_TIME);
+    ASSERT_NE(tempPasteboard->chunkSink_.reader, nullptr);
+    EXPECT_EQ(tempPasteboard->chunkSink_.reader->GetNextOffset(), TLVChunkWriter::CHUNK_SIZE);
+
+    tempPasteboard->SetDistributedChunkSource(event, writer);
+    auto [pasteData, result] = tempPasteboard->GetDistributedData(event, ACCOUNT_IDS_RANDOM);
+    ASSERT_NE(pasteData, nullptr);
+    EXPECT_EQ(result.errorCode, static_cast<int32_t>(PasteboardError::E_OK));
+    ASSERT_NE(pasteData->GetPrimaryText(), nullptr);
+    EXPECT_EQ(*pasteData->GetPrimaryText(), text);
+    EXPECT_EQ(clipPlugin->GetPasteDataCount(), 1);
+    EXPECT_EQ(tempPasteboard->chunkSink_.reader, nullptr);
+    tempPasteboard->clipPlugin_ = nullptr;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "PasteboardChunkTransferTest003 end");
+}
 } // namespace MiscServices
 } // namespace OHOS
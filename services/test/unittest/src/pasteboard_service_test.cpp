@@ -17,6 +17,7 @@
 #include <thread>
 #include <unistd.h>
 
+#include "global_event_codec.h"
 #include "ipc_skeleton.h"
 #include "message_parcel_warp.h"
 #include "parameters.h"
@@ -869,7 +870,7 @@ HWTEST_F(PasteboardServiceTest, GrantUriPermissionTest001, TestSize.Level1)
     PasteboardService service;
     std::map<uint32_t, std::vector<Uri>> emptyUris;
     uint32_t targetTokenId = 1;
-    int32_t result = service.GrantUriPermission(emptyUris, targetTokenId, false);
+    int32_t result = service.GrantUriPermission(emptyUris, targetTokenId, false, 0);
     EXPECT_EQ(result, static_cast<int32_t>(PasteboardError::E_OK));
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GrantUriPermissionTest001 end");
 }
@@ -1107,6 +1108,62 @@ HWTEST_F(PasteboardServiceTest, EstablishP2PLinkTaskTest001, TestSize.Level1)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "EstablishP2PLinkTaskTest001 end");
 }
 
+/**
+ * @tc.name: GlobalEventCodecTest001
+ * @tc.desc: the current event round trips through GlobalEventCodec for old and new peers, and keeps the fields
+ *           GetValidDistributeEvent compares
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, GlobalEventCodecTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GlobalEventCodecTest001 start");
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+
+    ClipPlugin::GlobalEvent event{};
+    event.frameNum = 1;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = UINT16_MAX;
+    event.status = ClipPlugin::EVT_NORMAL;
+    event.dataId = UINT32_ONE;
+    event.expiration = UINT64_MAX;
+    event.isDelay = true;
+    event.deviceId = "deviceId";
+    event.account = "account";
+    event.dataType = { MIMETYPE_TEXT_PLAIN, MIMETYPE_TEXT_HTML };
+    tempPasteboard->SetCurrentEvent(event);
+    auto currentEvent = tempPasteboard->GetCurrentEvent();
+
+    std::vector<uint8_t> json;
+    ASSERT_TRUE(GlobalEventCodec::Encode(currentEvent, DistributedModuleConfig::Version::VERSION_SIX, json));
+    EXPECT_FALSE(GlobalEventCodec::IsBinary(json));
+    std::vector<uint8_t> frame;
+    ASSERT_TRUE(GlobalEventCodec::Encode(currentEvent, DistributedModuleConfig::Version::VERSION_SEVEN, frame));
+    EXPECT_TRUE(GlobalEventCodec::IsBinary(frame));
+
+    for (const auto &buffer : { json, frame }) {
+        ClipPlugin::GlobalEvent decoded{};
+        ASSERT_TRUE(GlobalEventCodec::Decode(buffer, decoded));
+        EXPECT_EQ(decoded.deviceId, currentEvent.deviceId);
+        EXPECT_EQ(decoded.seqId, currentEvent.seqId);
+        EXPECT_EQ(decoded.expiration, currentEvent.expiration);
+        EXPECT_EQ(decoded.user, currentEvent.user);
+        EXPECT_EQ(decoded.status, currentEvent.status);
+        EXPECT_EQ(decoded.account, currentEvent.account);
+        EXPECT_EQ(decoded.dataType, currentEvent.dataType);
+    }
+
+    // only the TLV frame carries the data id and the delay flag
+    ClipPlugin::GlobalEvent decoded{};
+    ASSERT_TRUE(GlobalEventCodec::Decode(json, decoded));
+    EXPECT_EQ(decoded.dataId, 0U);
+    EXPECT_FALSE(decoded.isDelay);
+    ASSERT_TRUE(GlobalEventCodec::Decode(frame, decoded));
+    EXPECT_EQ(decoded.dataId, currentEvent.dataId);
+    EXPECT_TRUE(decoded.isDelay);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GlobalEventCodecTest001 end");
+}
+
 /**
  * @tc.name: CloseP2PLink001
  * @tc.desc: test Func CloseP2PLink
@@ -1328,6 +1385,83 @@ HWTEST_F(PasteboardServiceTest, DealDataTest001, TestSize.Level1)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DealDataTest001 end");
 }
 
+/**
+ * @tc.name: DealDataTest002
+ * @tc.desc: test Func DealData reuses the encoded records of an unchanged local clip
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, DealDataTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DealDataTest002 start");
+    constexpr int32_t userId = 111;
+    constexpr uint32_t dataId = 7;
+    auto service = std::make_shared<PasteboardService>();
+    auto clip = std::make_shared<PasteData>();
+    clip->AddTextRecord(std::string(64 * 1024, 'a'));
+    clip->SetDataId(dataId);
+    clip->userId_ = userId;
+    service->clips_.InsertOrAssign(userId, clip);
+
+    PasteData data = *clip;
+    auto first = service->GetEncodedRecords(data);
+    ASSERT_NE(first, nullptr);
+    auto second = service->GetEncodedRecords(data);
+    EXPECT_EQ(first, second);
+
+    int fd = -1;
+    int64_t size = 0;
+    std::vector<uint8_t> rawData;
+    EXPECT_EQ(service->DealData(fd, size, rawData, data), ERR_OK);
+    EXPECT_GT(size, static_cast<int64_t>(first->size()));
+
+    service->InvalidateEncodedClip(userId);
+    auto third = service->GetEncodedRecords(data);
+    ASSERT_NE(third, nullptr);
+    EXPECT_NE(first, third);
+    EXPECT_EQ(*first, *third);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DealDataTest002 end");
+}
+
+/**
+ * @tc.name: DealDataTest003
+ * @tc.desc: test Func GetEncodedRecords keeps one variant per paste target and per user
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, DealDataTest003, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DealDataTest003 start");
+    constexpr int32_t userId = 111;
+    constexpr int32_t otherUserId = 112;
+    constexpr uint32_t dataId = 7;
+    auto service = std::make_shared<PasteboardService>();
+    auto clip = std::make_shared<PasteData>();
+    clip->AddTextRecord(std::string(64 * 1024, 'a'));
+    clip->SetDataId(dataId);
+    clip->userId_ = userId;
+    service->clips_.InsertOrAssign(userId, clip);
+    auto otherClip = std::make_shared<PasteData>(*clip);
+    otherClip->userId_ = otherUserId;
+    service->clips_.InsertOrAssign(otherUserId, otherClip);
+
+    PasteData data = *clip;
+    PasteData converted = *clip;
+    converted.PeekRecords()[0]->SetConvertUri("file://docs/storage/a.txt");
+    PasteData otherData = *otherClip;
+    auto plain = service->GetEncodedRecords(data);
+    auto uris = service->GetEncodedRecords(converted);
+    auto other = service->GetEncodedRecords(otherData);
+    ASSERT_NE(plain, nullptr);
+    ASSERT_NE(uris, nullptr);
+    EXPECT_NE(plain, uris);
+    EXPECT_EQ(service->GetEncodedRecords(data), plain);
+    EXPECT_EQ(service->GetEncodedRecords(converted), uris);
+
+    service->InvalidateEncodedClip(userId);
+    EXPECT_EQ(service->GetEncodedRecords(otherData), other);
+    EXPECT_NE(service->GetEncodedRecords(data), plain);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DealDataTest003 end");
+}
+
 /**
  * @tc.name: AddPermissionRecordTest001
  * @tc.desc: test Func AddPermissionRecord
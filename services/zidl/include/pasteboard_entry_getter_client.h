@@ -28,6 +28,8 @@ public:
     explicit PasteboardEntryGetterClient(const std::map<uint32_t, std::shared_ptr<UDMF::EntryGetter>> entryGetters);
     ~PasteboardEntryGetterClient() = default;
     int32_t GetRecordValueByType(uint32_t recordId, PasteDataEntry& value) override;
+    int32_t GetRecordValuesByType(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+        std::vector<PasteDataEntry> &values, std::vector<int32_t> &results) override;
 private:
     std::map<uint32_t, std::shared_ptr<UDMF::EntryGetter>> entryGetters_;
 };
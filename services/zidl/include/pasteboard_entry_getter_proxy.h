@@ -26,8 +26,12 @@ public:
     explicit PasteboardEntryGetterProxy(const sptr<IRemoteObject> &object);
     ~PasteboardEntryGetterProxy() = default;
     int32_t GetRecordValueByType(uint32_t recordId, PasteDataEntry& value) override;
+    int32_t GetRecordValuesByType(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+        std::vector<PasteDataEntry> &values, std::vector<int32_t> &results) override;
 private:
     int32_t MakeRequest(uint32_t recordId, PasteDataEntry& value, MessageParcel& request);
+    int32_t MakeBatchRequest(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+        const std::vector<PasteDataEntry> &values, MessageParcel &request);
     static inline BrokerDelegator<PasteboardEntryGetterProxy> delegator_;
 };
 } // namespace MiscServices
@@ -52,8 +52,7 @@ void PasteboardDelayGetterProxy::GetPasteData(const std::string &type, PasteData
     const uint8_t *rawData = reinterpret_cast<const uint8_t *>(messageReply.ReadRawData(reply, rawDataSize));
     PASTEBOARD_CHECK_AND_RETURN_LOGE(rawData != nullptr,
         PASTEBOARD_MODULE_CLIENT, "fail to get raw data, size=%{public}" PRId64, rawDataSize);
-    std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-    bool ret = data.Decode(pasteDataTlv);
+    bool ret = data.Decode(rawData, static_cast<size_t>(rawDataSize));
     PASTEBOARD_CHECK_AND_RETURN_LOGE(ret, PASTEBOARD_MODULE_CLIENT, "fail to decode paste data");
     data.rawDataSize_ = rawDataSize;
 }
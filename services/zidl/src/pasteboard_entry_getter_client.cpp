@@ -40,5 +40,32 @@ int32_t PasteboardEntryGetterClient::GetRecordValueByType(uint32_t recordId, Pas
     }
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
+
+int32_t PasteboardEntryGetterClient::GetRecordValuesByType(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+    std::vector<PasteDataEntry> &values, std::vector<int32_t> &results)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(recordIds.size() == values.size(),
+        static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR), PASTEBOARD_MODULE_CLIENT,
+        "invalid entry count, ids=%{public}zu, values=%{public}zu", recordIds.size(), values.size());
+    results.assign(recordIds.size(), static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION));
+    int64_t remainSize = maxSize;
+    for (size_t i = 0; i < recordIds.size() && remainSize > 0; ++i) {
+        results[i] = GetRecordValueByType(recordIds[i], values[i]);
+        if (results[i] != static_cast<int32_t>(PasteboardError::E_OK)) {
+            continue;
+        }
+        auto valueSize = static_cast<int64_t>(values[i].Count());
+        if (valueSize > remainSize) {
+            // only this value is dropped, smaller ones after it may still fit
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "value too large, index=%{public}zu, size=%{public}" PRId64,
+                i, valueSize);
+            values[i].SetValue(std::monostate{});
+            results[i] = static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION);
+            continue;
+        }
+        remainSize -= valueSize;
+    }
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
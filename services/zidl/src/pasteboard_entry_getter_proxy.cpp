@@ -82,9 +82,8 @@ int32_t PasteboardEntryGetterProxy::GetRecordValueByType(uint32_t recordId, Past
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr,
         static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
         PASTEBOARD_MODULE_SERVICE, "read entry tlv raw data failed, size=%{public}" PRId64, rawDataSize);
-    std::vector<uint8_t> recvEntryTlv(rawData, rawData + rawDataSize);
     PasteDataEntry entryValue;
-    if (!entryValue.Decode(recvEntryTlv)) {
+    if (!entryValue.Decode(rawData, static_cast<size_t>(rawDataSize))) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "unmarshall entry value failed");
         return static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
     }
@@ -92,5 +91,90 @@ int32_t PasteboardEntryGetterProxy::GetRecordValueByType(uint32_t recordId, Past
     value.rawDataSize_ = rawDataSize;
     return res;
 }
+
+int32_t PasteboardEntryGetterProxy::MakeBatchRequest(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+    const std::vector<PasteDataEntry> &values, MessageParcel &request)
+{
+    if (!request.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write descriptor failed");
+        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+    }
+    std::vector<uint8_t> sendEntriesTLV;
+    std::vector<int64_t> entrySizes;
+    for (const auto &value : values) {
+        std::vector<uint8_t> entryTLV;
+        if (!value.Encode(entryTLV)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "marshall entry value failed");
+            return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+        }
+        entrySizes.push_back(static_cast<int64_t>(entryTLV.size()));
+        sendEntriesTLV.insert(sendEntriesTLV.end(), entryTLV.begin(), entryTLV.end());
+    }
+    if (!request.WriteUInt32Vector(recordIds) || !request.WriteInt64Vector(entrySizes) ||
+        !request.WriteInt64(maxSize) || !request.WriteInt64(sendEntriesTLV.size())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write entry ids or sizes failed");
+        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+    }
+    MessageParcelWarp messageRequest;
+    size_t tlvSize = sendEntriesTLV.size();
+    if (!messageRequest.WriteRawData(request, sendEntriesTLV.data(), tlvSize)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write entries tlv raw data failed size:%{public}zu", tlvSize);
+        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+    }
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+int32_t PasteboardEntryGetterProxy::GetRecordValuesByType(const std::vector<uint32_t> &recordIds, int64_t maxSize,
+    std::vector<PasteDataEntry> &values, std::vector<int32_t> &results)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!recordIds.empty() && recordIds.size() == values.size(),
+        static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "invalid entry count, ids=%{public}zu, values=%{public}zu", recordIds.size(), values.size());
+    MessageParcel request;
+    auto res = MakeBatchRequest(recordIds, maxSize, values, request);
+    if (res != static_cast<int32_t>(PasteboardError::E_OK)) {
+        return res;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    int result = Remote()->SendRequest(
+        static_cast<int>(PasteboardEntryGetterInterfaceCode::GET_RECORD_VALUES_BY_TYPE), request, reply, option);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(result != IPC_STUB_UNKNOW_TRANS_ERR,
+        static_cast<int32_t>(PasteboardError::NOT_SUPPORT), PASTEBOARD_MODULE_SERVICE, "batch call not supported");
+    if (result != ERR_OK) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "send request failed, error:%{public}d", result);
+        return static_cast<int32_t>(PasteboardError::REMOTE_TASK_ERROR);
+    }
+    res = reply.ReadInt32();
+    std::vector<int32_t> entryResults;
+    std::vector<int64_t> entrySizes;
+    int64_t rawDataSize = 0;
+    MessageParcelWarp messageReply;
+    bool isValid = reply.ReadInt32Vector(&entryResults) && reply.ReadInt64Vector(&entrySizes) &&
+        reply.ReadInt64(rawDataSize) && entryResults.size() == values.size() && entrySizes.size() == values.size() &&
+        rawDataSize > 0 && rawDataSize <= messageReply.GetRawDataSize();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(isValid, static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "read entry results failed");
+    const uint8_t *rawData = reinterpret_cast<const uint8_t *>(messageReply.ReadRawData(reply, rawDataSize));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr,
+        static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "read entries tlv raw data failed, size=%{public}" PRId64, rawDataSize);
+    int64_t offset = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(entrySizes[i] > 0 && entrySizes[i] <= rawDataSize - offset,
+            static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+            "invalid entry size, index=%{public}zu", i);
+        PasteDataEntry entryValue;
+        if (!entryValue.Decode(rawData + offset, static_cast<size_t>(entrySizes[i]))) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "unmarshall entry value failed, index=%{public}zu", i);
+            return static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+        }
+        values[i] = entryValue;
+        values[i].rawDataSize_ = entrySizes[i];
+        offset += entrySizes[i];
+    }
+    results = std::move(entryResults);
+    return res;
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -27,6 +27,8 @@ PasteboardEntryGetterStub::PasteboardEntryGetterStub()
 {
     memberFuncMap_[static_cast<uint32_t>(PasteboardEntryGetterInterfaceCode::GET_RECORD_VALUE_BY_TYPE)] =
         &PasteboardEntryGetterStub::OnGetRecordValueByType;
+    memberFuncMap_[static_cast<uint32_t>(PasteboardEntryGetterInterfaceCode::GET_RECORD_VALUES_BY_TYPE)] =
+        &PasteboardEntryGetterStub::OnGetRecordValuesByType;
 }
 
 PasteboardEntryGetterStub::~PasteboardEntryGetterStub()
@@ -67,9 +69,8 @@ int32_t PasteboardEntryGetterStub::OnGetRecordValueByType(MessageParcel &data, M
     const uint8_t *rawData = reinterpret_cast<const uint8_t *>(messageData.ReadRawData(data, rawDataSize));
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr, ERR_INVALID_VALUE,
         PASTEBOARD_MODULE_CLIENT, "read entry tlv raw data failed, size=%{public}" PRId64, rawDataSize);
-    std::vector<uint8_t> recvEntryTlv(rawData, rawData + rawDataSize);
     PasteDataEntry entryValue;
-    bool ret = entryValue.Decode(recvEntryTlv);
+    bool ret = entryValue.Decode(rawData, static_cast<size_t>(rawDataSize));
     if (!ret) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "unmarshall entry value failed");
         return ERR_INVALID_VALUE;
@@ -97,5 +98,62 @@ int32_t PasteboardEntryGetterStub::OnGetRecordValueByType(MessageParcel &data, M
     }
     return ERR_OK;
 }
+
+int32_t PasteboardEntryGetterStub::OnGetRecordValuesByType(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<uint32_t> recordIds;
+    std::vector<int64_t> entrySizes;
+    int64_t maxSize = 0;
+    int64_t rawDataSize = 0;
+    MessageParcelWarp messageData;
+    bool isValid = data.ReadUInt32Vector(&recordIds) && data.ReadInt64Vector(&entrySizes) &&
+        data.ReadInt64(maxSize) && data.ReadInt64(rawDataSize) && !recordIds.empty() &&
+        recordIds.size() == entrySizes.size() && maxSize > 0 && rawDataSize > 0 &&
+        rawDataSize <= messageData.GetRawDataSize();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(isValid, ERR_INVALID_VALUE, PASTEBOARD_MODULE_CLIENT,
+        "invalid entry ids or sizes");
+    const uint8_t *rawData = reinterpret_cast<const uint8_t *>(messageData.ReadRawData(data, rawDataSize));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr, ERR_INVALID_VALUE,
+        PASTEBOARD_MODULE_CLIENT, "read entries tlv raw data failed, size=%{public}" PRId64, rawDataSize);
+    std::vector<PasteDataEntry> values(recordIds.size());
+    int64_t offset = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(entrySizes[i] > 0 && entrySizes[i] <= rawDataSize - offset,
+            ERR_INVALID_VALUE, PASTEBOARD_MODULE_CLIENT, "invalid entry size, index=%{public}zu", i);
+        if (!values[i].Decode(rawData + offset, static_cast<size_t>(entrySizes[i]))) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "unmarshall entry value failed, index=%{public}zu", i);
+            return ERR_INVALID_VALUE;
+        }
+        offset += entrySizes[i];
+    }
+    std::vector<int32_t> results;
+    auto result = GetRecordValuesByType(recordIds, maxSize, values, results);
+    if (results.size() != values.size()) {
+        results.assign(values.size(), result);
+    }
+    std::vector<uint8_t> sendEntriesTLV;
+    std::vector<int64_t> sendSizes;
+    for (const auto &value : values) {
+        std::vector<uint8_t> entryTLV;
+        if (!value.Encode(entryTLV)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "marshall entry value failed");
+            return ERR_INVALID_VALUE;
+        }
+        sendSizes.push_back(static_cast<int64_t>(entryTLV.size()));
+        sendEntriesTLV.insert(sendEntriesTLV.end(), entryTLV.begin(), entryTLV.end());
+    }
+    if (!reply.WriteInt32(result) || !reply.WriteInt32Vector(results) || !reply.WriteInt64Vector(sendSizes) ||
+        !reply.WriteInt64(sendEntriesTLV.size())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write entry results failed, result:%{public}d", result);
+        return ERR_INVALID_VALUE;
+    }
+    MessageParcelWarp messageReply;
+    size_t tlvSize = sendEntriesTLV.size();
+    if (!messageReply.WriteRawData(reply, sendEntriesTLV.data(), tlvSize)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write entries tlv raw data failed size:%{public}zu", tlvSize);
+        return ERR_INVALID_VALUE;
+    }
+    return ERR_OK;
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file